@@ -1,6 +1,19 @@
+#include <format>
 #include <iostream>
-#include <uuid.h>
-#include <uuid_factory.h>
+#include <random>
+#include <unordered_map>
+#include <uuid.hpp>
+#include <uuid_bulk.hpp>
+#include <uuid_column.hpp>
+#include <uuid_concurrent.hpp>
+#include <uuid_factory.hpp>
+#include <uuid_flat_map.hpp>
+#include <uuid_index.hpp>
+#include <uuid_pool.hpp>
+#include <uuid_search.hpp>
+#include <uuid_sequencer.hpp>
+#include <uuid_sort.hpp>
+#include <uuid_v8.hpp>
 #include <benchmark/benchmark.h>
 
 #ifdef WIN32
@@ -10,13 +23,15 @@
 
 using namespace LambdaSnail::Uuid;
 
+static uuid_factory<std::mt19937_64> factory;
+
 static void BM_create_batch_dedicated_counter(benchmark::State& state) {
     auto const num_uuids = static_cast<uint16_t>(state.range(0));
 
     for (auto _ : state)
     {
         std::vector<uuid> uuid_vec;
-        factory::create_uuids_dedicated_counter(num_uuids, uuid_vec);
+        factory.create_uuids_dedicated_counter(num_uuids, uuid_vec);
     }
 }
 
@@ -25,8 +40,57 @@ static void BM_create_batch_monotonic_counter(benchmark::State& state) {
     for (auto _ : state)
     {
         std::vector<uuid> uuid_vec;
-        factory::create_uuids_monotonic_random(num_uuids, 1, uuid_vec);
+        factory.create_uuids_monotonic_random(num_uuids, 1, uuid_vec);
+    }
+}
+
+static void BM_create_span_dedicated_counter(benchmark::State& state) {
+    std::vector<uuid> uuid_vec(state.range(0));
+
+    for (auto _ : state)
+    {
+        factory.create_uuids_dedicated_counter(uuid_vec);
+        benchmark::DoNotOptimize(uuid_vec.data());
+    }
+
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+static void BM_create_span_rolling_counter(benchmark::State& state) {
+    std::vector<uuid> uuid_vec(state.range(0));
+
+    // Once the timestamp is the maximum skew ahead, this runs at the limit of 4096 uuids per millisecond
+    for (auto _ : state)
+    {
+        factory.create_uuids_rolling_counter(uuid_vec);
+        benchmark::DoNotOptimize(uuid_vec.data());
+    }
+
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+static void BM_create_span_monotonic_counter(benchmark::State& state) {
+    std::vector<uuid> uuid_vec(state.range(0));
+
+    for (auto _ : state)
+    {
+        factory.create_uuids_monotonic_random(uuid_vec, 1);
+        benchmark::DoNotOptimize(uuid_vec.data());
+    }
+
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+static void BM_create_span_random_increment(benchmark::State& state) {
+    std::vector<uuid> uuid_vec(state.range(0));
+
+    for (auto _ : state)
+    {
+        factory.create_uuids_random_increment(uuid_vec, 1000);
+        benchmark::DoNotOptimize(uuid_vec.data());
     }
+
+    state.SetItemsProcessed(state.iterations() * state.range(0));
 }
 
 static void BM_create_uuid_v4(benchmark::State& state) {
@@ -34,8 +98,35 @@ static void BM_create_uuid_v4(benchmark::State& state) {
     for (auto _ : state)
     {
         uuid id;
-        factory::create_uuid_v4(id);
+        factory.create_uuid_v4(id);
+    }
+}
+
+static void BM_create_uuid_v4_loop(benchmark::State& state) {
+    std::vector<uuid> ids(state.range(0));
+
+    for (auto _ : state)
+    {
+        for (uuid& id : ids)
+        {
+            factory.create_uuid_v4(id);
+        }
+        benchmark::DoNotOptimize(ids.data());
+    }
+
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+static void BM_create_uuids_v4(benchmark::State& state) {
+    std::vector<uuid> ids(state.range(0));
+
+    for (auto _ : state)
+    {
+        factory.create_uuids_v4(ids);
+        benchmark::DoNotOptimize(ids.data());
     }
+
+    state.SetItemsProcessed(state.iterations() * state.range(0));
 }
 
 static void BM_create_uuid_v7(benchmark::State& state) {
@@ -43,15 +134,176 @@ static void BM_create_uuid_v7(benchmark::State& state) {
     for (auto _ : state)
     {
         uuid id;
-        factory::create_uuid_v7(id);
+        factory.create_uuid_v7(id);
+    }
+}
+
+static void BM_create_uuid_v8(benchmark::State& state) {
+
+    for (auto _ : state)
+    {
+        uuid id;
+        factory.create_uuid_v8<v8_layout<>>(42, id);
+        benchmark::DoNotOptimize(id);
+    }
+}
+
+static void BM_v8_shard(benchmark::State& state) {
+    uuid id;
+    factory.create_uuid_v8<v8_layout<>>(42, id);
+
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(id);
+        benchmark::DoNotOptimize(v8_layout<>::shard(id));
+    }
+}
+
+static void BM_create_uuid_v5(benchmark::State& state) {
+    std::string const name = "customer-0123456789@example.com";
+
+    for (auto _ : state)
+    {
+        uuid id;
+        factory.create_uuid_v5(namespace_url, name, id);
+        benchmark::DoNotOptimize(id);
+    }
+}
+
+static void BM_create_uuids_v5(benchmark::State& state) {
+    std::vector<std::string> storage;
+    for (int64_t i = 0; i < state.range(0); ++i)
+    {
+        storage.push_back(std::format("customer-{:010}@example.com", i));
+    }
+
+    std::vector<std::string_view> const names(storage.begin(), storage.end());
+    std::vector<uuid> ids(names.size());
+
+    for (auto _ : state)
+    {
+        factory.create_uuids_v5(namespace_url, names, ids);
+        benchmark::DoNotOptimize(ids.data());
+    }
+
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+static void BM_create_uuid_v7_monotonic(benchmark::State& state) {
+
+    for (auto _ : state)
+    {
+        uuid id;
+        factory.create_uuid_v7_monotonic(id);
+    }
+}
+
+template<typename clock_policy_t>
+static void BM_create_uuid_v7_clock(benchmark::State& state) {
+    uuid_factory<std::mt19937_64, clock_policy_t> clock_factory;
+
+    for (auto _ : state)
+    {
+        uuid id;
+        clock_factory.create_uuid_v7(id);
+        benchmark::DoNotOptimize(id);
+    }
+}
+
+template<typename clock_policy_t>
+static void BM_create_uuid_v7_monotonic_clock(benchmark::State& state) {
+    uuid_factory<std::mt19937_64, clock_policy_t> clock_factory;
+
+    for (auto _ : state)
+    {
+        uuid id;
+        clock_factory.create_uuid_v7_monotonic(id);
+        benchmark::DoNotOptimize(id);
+    }
+}
+
+static v7_sequencer<cached_clock_policy> shared_sequencer;
+
+static void BM_create_uuid_v7_sequencer(benchmark::State& state) {
+    concurrent_uuid_factory<> concurrent_factory;
+
+    for (auto _ : state)
+    {
+        uuid id;
+        concurrent_factory.create_uuid_v7(shared_sequencer, id);
+        benchmark::DoNotOptimize(id);
+    }
+}
+
+static void BM_create_uuids_v7_sequencer_block(benchmark::State& state) {
+    concurrent_uuid_factory<> concurrent_factory;
+    std::vector<uuid> ids(state.range(0));
+
+    for (auto _ : state)
+    {
+        concurrent_factory.create_uuids_v7(shared_sequencer, ids);
+        benchmark::DoNotOptimize(ids.data());
+    }
+
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+static void BM_v7_view(benchmark::State& state) {
+    auto view = factory.v7_view();
+    auto it = view.begin();
+
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(*it);
+        ++it;
+    }
+}
+
+static void BM_v4_view(benchmark::State& state) {
+    auto view = factory.v4_view();
+    auto it = view.begin();
+
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(*it);
+        ++it;
+    }
+}
+
+static void BM_create_uuid_v4_concurrent(benchmark::State& state) {
+    concurrent_uuid_factory<> concurrent_factory;
+
+    for (auto _ : state)
+    {
+        uuid id;
+        concurrent_factory.create_uuid_v4(id);
+        benchmark::DoNotOptimize(id);
+    }
+}
+
+static void BM_uuid_pool_pop(benchmark::State& state) {
+    static uuid_pool<> pool(uuid_pool_kind::v7, { .depth = 1 << 16, .low_water_mark = 1 << 14 });
+    uint64_t const fallbacks_before = pool.num_fallbacks();
+
+    for (auto _ : state)
+    {
+        uuid id;
+        pool.pop(id);
+        benchmark::DoNotOptimize(id);
+    }
+
+    // A tight loop takes uuids faster than the producer creates them, so some are created inline
+    if (state.thread_index() == 0)
+    {
+        state.counters["fallbacks"] = static_cast<double>(pool.num_fallbacks() - fallbacks_before);
     }
 }
 
 static void BM_EqualityComparison(benchmark::State& state)
 {
     uuid id1, id2;
-    factory::create_uuid_v4(id1);
-    factory::create_uuid_v4(id2);
+    factory.create_uuid_v4(id1);
+    factory.create_uuid_v4(id2);
 
     for (auto _ : state)
     {
@@ -62,8 +314,8 @@ static void BM_EqualityComparison(benchmark::State& state)
 static void BM_LessThan(benchmark::State& state)
 {
     uuid id1, id2;
-    factory::create_uuid_v4(id1);
-    factory::create_uuid_v4(id2);
+    factory.create_uuid_v4(id1);
+    factory.create_uuid_v4(id2);
 
     for (auto _ : state)
     {
@@ -71,6 +323,338 @@ static void BM_LessThan(benchmark::State& state)
     }
 }
 
+// The std::format based implementation that as_string used before to_chars was added
+static std::string as_string_std_format(uuid const& id)
+{
+    auto const& o = id.octets;
+    return std::format(
+            "{:02x}{:02x}{:02x}{:02x}-{:02x}{:02x}-{:02x}{:02x}-{:02x}{:02x}-{:02x}{:02x}{:02x}{:02x}{:02x}{:02x}",
+            o[0], o[1], o[2], o[3], o[4], o[5], o[6], o[7], o[8], o[9], o[10], o[11], o[12], o[13], o[14], o[15]);
+}
+
+static void BM_AsStringStdFormat(benchmark::State& state)
+{
+    uuid id;
+    factory.create_uuid_v4(id);
+
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize( as_string_std_format(id) );
+    }
+}
+
+static void BM_AsString(benchmark::State& state)
+{
+    uuid id;
+    factory.create_uuid_v4(id);
+
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize( id.as_string() );
+    }
+}
+
+template<string_conversion_mode M>
+static void BM_ToChars(benchmark::State& state)
+{
+    uuid id;
+    factory.create_uuid_v4(id);
+    std::array<char, string_length<M>> buffer;
+
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize( to_chars<M>(buffer.data(), buffer.data() + buffer.size(), id) );
+        benchmark::ClobberMemory();
+    }
+}
+
+static void BM_FromString(benchmark::State& state)
+{
+    uuid id;
+    factory.create_uuid_v4(id);
+    std::string const str = id.as_string();
+
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize( uuid::from_string(str, id) );
+    }
+}
+
+template<string_conversion_mode M>
+static void BM_FromChars(benchmark::State& state)
+{
+    uuid id;
+    factory.create_uuid_v4(id);
+    std::string const str = id.as_string<M>();
+
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize( from_chars<M>(str.data(), str.data() + str.size(), id) );
+    }
+}
+
+static std::vector<uuid> make_v4_uuids(size_t num_uuids)
+{
+    std::vector<uuid> ids(num_uuids);
+    for (uuid& id : ids)
+    {
+        factory.create_uuid_v4(id);
+    }
+
+    return ids;
+}
+
+static void BM_FormatUuidsAsString(benchmark::State& state)
+{
+    std::vector<uuid> const ids = make_v4_uuids(state.range(0));
+
+    for (auto _ : state)
+    {
+        std::string text;
+        for (uuid const& id : ids)
+        {
+            text += id.as_string();
+            text += '\n';
+        }
+
+        benchmark::DoNotOptimize( text.data() );
+    }
+
+    state.SetBytesProcessed(state.iterations() * bulk_string_length(ids.size()));
+}
+
+static void BM_FormatUuids(benchmark::State& state)
+{
+    std::vector<uuid> const ids = make_v4_uuids(state.range(0));
+    std::string text(bulk_string_length(ids.size()), '\0');
+
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize( format_uuids(ids, '\n', text) );
+        benchmark::ClobberMemory();
+    }
+
+    state.SetBytesProcessed(state.iterations() * text.size());
+}
+
+static void BM_ParseUuids(benchmark::State& state)
+{
+    std::vector<uuid> ids = make_v4_uuids(state.range(0));
+    std::string text(bulk_string_length(ids.size()), '\0');
+    std::ignore = format_uuids(ids, '\n', text);
+
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize( parse_uuids(text, std::span<uuid>(ids)) );
+        benchmark::ClobberMemory();
+    }
+
+    state.SetBytesProcessed(state.iterations() * text.size());
+}
+
+template<typename map_t>
+static void BM_MapFind(benchmark::State& state)
+{
+    std::vector<uuid> const ids = make_v4_uuids(state.range(0));
+
+    map_t map;
+    for (size_t i = 0; i < ids.size(); ++i)
+    {
+        map[ids[i]] = i;
+    }
+
+    size_t i = 0;
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize( map.find(ids[i]) );
+        i = i + 1 == ids.size() ? 0 : i + 1;
+    }
+}
+
+template<void (*Sort)(std::vector<uuid>&)>
+static void BM_Sort(benchmark::State& state)
+{
+    std::vector<uuid> const ids = make_v4_uuids(state.range(0));
+
+    for (auto _ : state)
+    {
+        state.PauseTiming();
+        std::vector<uuid> copy = ids;
+        state.ResumeTiming();
+
+        Sort(copy);
+        benchmark::DoNotOptimize( copy.data() );
+    }
+}
+
+static void std_sort(std::vector<uuid>& ids) { std::sort(ids.begin(), ids.end()); }
+static void radix_sort(std::vector<uuid>& ids) { uuid_sort(ids); }
+static void radix_sort_parallel(std::vector<uuid>& ids) { uuid_sort_parallel(ids); }
+
+static void BM_StdFind(benchmark::State& state)
+{
+    std::vector<uuid> const ids = make_v4_uuids(state.range(0));
+
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize( std::find(ids.begin(), ids.end(), uuid::max) );
+    }
+
+    state.SetItemsProcessed(state.iterations() * ids.size());
+}
+
+static void BM_UuidIndexOf(benchmark::State& state)
+{
+    std::vector<uuid> const ids = make_v4_uuids(state.range(0));
+
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize( uuid_index_of(ids, uuid::max) );
+    }
+
+    state.SetItemsProcessed(state.iterations() * ids.size());
+}
+
+static void BM_UuidIndexOfMultiple(benchmark::State& state)
+{
+    std::vector<uuid> const ids = make_v4_uuids(state.range(0));
+    std::vector<uuid> const needles = make_v4_uuids(8);
+    std::vector<size_t> indices(needles.size());
+
+    for (auto _ : state)
+    {
+        uuid_index_of(ids, needles, indices);
+        benchmark::DoNotOptimize( indices.data() );
+    }
+
+    state.SetItemsProcessed(state.iterations() * ids.size() * needles.size());
+}
+
+static std::vector<uuid> make_monotonic_uuids(size_t num_uuids)
+{
+    std::vector<uuid> ids;
+    factory.create_uuids_random_increment(static_cast<uint32_t>(num_uuids), 1u << 16, ids);
+    return ids;
+}
+
+static void BM_MemcpyUuids(benchmark::State& state)
+{
+    std::vector<uuid> const ids = make_monotonic_uuids(state.range(0));
+    std::vector<uuid> copy(ids.size());
+
+    for (auto _ : state)
+    {
+        std::memcpy(copy.data(), ids.data(), ids.size() * sizeof(uuid));
+        benchmark::ClobberMemory();
+    }
+
+    state.SetBytesProcessed(state.iterations() * ids.size() * sizeof(uuid));
+}
+
+static void BM_ColumnDecode(benchmark::State& state)
+{
+    std::vector<uuid> ids = make_monotonic_uuids(state.range(0));
+    uuid_column column;
+    column.append(ids);
+    state.counters["bytes_per_uuid"] = static_cast<double>(column.memory_usage()) / static_cast<double>(column.size());
+
+    for (auto _ : state)
+    {
+        column.decode(0, ids);
+        benchmark::ClobberMemory();
+    }
+
+    state.SetBytesProcessed(state.iterations() * ids.size() * sizeof(uuid));
+}
+
+static void BM_ColumnAt(benchmark::State& state)
+{
+    uuid_column column;
+    column.append(make_monotonic_uuids(state.range(0)));
+
+    size_t i = 0;
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize( column[i] );
+        i = (i + 7919) % column.size();
+    }
+}
+
+static std::vector<uuid> make_sorted_v7_uuids(size_t num_uuids)
+{
+    std::vector<uuid> ids(num_uuids);
+    for (uuid& id : ids)
+    {
+        factory.create_uuid_v7(id);
+    }
+
+    uuid_sort(ids);
+    return ids;
+}
+
+static void BM_SortedVectorLowerBound(benchmark::State& state)
+{
+    std::vector<uuid> const ids = make_sorted_v7_uuids(state.range(0));
+
+    size_t i = 0;
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize( std::lower_bound(ids.begin(), ids.end(), ids[i]) );
+        i = (i + 7919) % ids.size();
+    }
+}
+
+static void BM_IndexFileFind(benchmark::State& state)
+{
+    std::vector<uuid> const ids = make_sorted_v7_uuids(state.range(0));
+    uuid file_id;
+    factory.create_uuid_v4(file_id);
+    std::filesystem::path const path = std::filesystem::temp_directory_path() / ("uuid_index_bm_" + file_id.as_string() + ".bin");
+    std::ignore = write_uuid_index(ids, path);
+
+    uuid_index_file index;
+    std::ignore = index.open(path);
+
+    size_t i = 0;
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize( index.find(ids[i]) );
+        i = (i + 7919) % ids.size();
+    }
+
+    index.close();
+    std::filesystem::remove(path);
+}
+
+static void BM_IndexFileFindBatch(benchmark::State& state)
+{
+    std::vector<uuid> const ids = make_sorted_v7_uuids(state.range(0));
+    uuid file_id;
+    factory.create_uuid_v4(file_id);
+    std::filesystem::path const path = std::filesystem::temp_directory_path() / ("uuid_index_bm_" + file_id.as_string() + ".bin");
+    std::ignore = write_uuid_index(ids, path);
+
+    uuid_index_file index;
+    std::ignore = index.open(path);
+
+    std::vector<uuid> needles(1024);
+    for (size_t i = 0; i < needles.size(); ++i)
+    {
+        needles[i] = ids[(i * 7919) % ids.size()];
+    }
+
+    std::vector<size_t> indices(needles.size());
+    for (auto _ : state)
+    {
+        index.find(needles, indices);
+        benchmark::DoNotOptimize( indices.data() );
+    }
+
+    state.SetItemsProcessed(state.iterations() * needles.size());
+    index.close();
+    std::filesystem::remove(path);
+}
+
 #ifdef WIN32
 
 // Benchmark for comparison with Windows functions
@@ -97,7 +681,28 @@ static void BM_WIN_uuid_create_sequential(benchmark::State& state) {
 
 
 BENCHMARK(BM_create_uuid_v4);//->Repetitions(100);
+BENCHMARK(BM_create_uuid_v4_loop)->Arg(4096);
+BENCHMARK(BM_create_uuids_v4)->Arg(4096);
 BENCHMARK(BM_create_uuid_v7);//->Repetitions(100);
+BENCHMARK(BM_create_uuid_v7_monotonic);
+BENCHMARK(BM_create_uuid_v8);
+BENCHMARK(BM_v8_shard);
+BENCHMARK(BM_create_uuid_v5);
+BENCHMARK(BM_create_uuids_v5)->Arg(4096);
+BENCHMARK(BM_v7_view);
+BENCHMARK(BM_v4_view);
+BENCHMARK_TEMPLATE(BM_create_uuid_v7_clock, system_clock_policy);
+BENCHMARK_TEMPLATE(BM_create_uuid_v7_clock, coarse_clock_policy);
+BENCHMARK_TEMPLATE(BM_create_uuid_v7_clock, tsc_clock_policy);
+BENCHMARK_TEMPLATE(BM_create_uuid_v7_clock, cached_clock_policy);
+BENCHMARK_TEMPLATE(BM_create_uuid_v7_monotonic_clock, system_clock_policy);
+BENCHMARK_TEMPLATE(BM_create_uuid_v7_monotonic_clock, coarse_clock_policy);
+BENCHMARK_TEMPLATE(BM_create_uuid_v7_monotonic_clock, tsc_clock_policy);
+BENCHMARK_TEMPLATE(BM_create_uuid_v7_monotonic_clock, cached_clock_policy);
+BENCHMARK(BM_create_uuid_v4_concurrent)->ThreadRange(1, 64)->UseRealTime();
+BENCHMARK(BM_uuid_pool_pop)->ThreadRange(1, 8)->UseRealTime();
+BENCHMARK(BM_create_uuid_v7_sequencer)->ThreadRange(1, 64)->UseRealTime();
+BENCHMARK(BM_create_uuids_v7_sequencer_block)->Arg(64)->ThreadRange(1, 64)->UseRealTime();
 // BENCHMARK(BM_WIN_cocreate_guid);
 // BENCHMARK(BM_WIN_uuid_create_sequential);
 //
@@ -105,6 +710,48 @@ BENCHMARK(BM_create_uuid_v7);//->Repetitions(100);
 BENCHMARK(BM_EqualityComparison);//->Repetitions(100);
 BENCHMARK(BM_LessThan);//->Repetitions(100);
 
+BENCHMARK(BM_AsStringStdFormat);
+BENCHMARK(BM_AsString);
+BENCHMARK_TEMPLATE(BM_ToChars, string_conversion_mode::standard);
+BENCHMARK_TEMPLATE(BM_ToChars, string_conversion_mode::curly_braces);
+BENCHMARK_TEMPLATE(BM_ToChars, string_conversion_mode::no_dash);
+BENCHMARK_TEMPLATE(BM_ToChars, string_conversion_mode::base64url);
+BENCHMARK_TEMPLATE(BM_ToChars, string_conversion_mode::base32);
+BENCHMARK_TEMPLATE(BM_ToChars, string_conversion_mode::base58);
+BENCHMARK(BM_FromString);
+BENCHMARK_TEMPLATE(BM_FromChars, string_conversion_mode::base64url);
+BENCHMARK_TEMPLATE(BM_FromChars, string_conversion_mode::base32);
+BENCHMARK_TEMPLATE(BM_FromChars, string_conversion_mode::base58);
+
+BENCHMARK(BM_FormatUuidsAsString)->Arg(10000);
+BENCHMARK(BM_FormatUuids)->Arg(10000);
+BENCHMARK(BM_ParseUuids)->Arg(10000);
+
+BENCHMARK_TEMPLATE(BM_MapFind, std::unordered_map<uuid, size_t>)->Arg(100000);
+BENCHMARK_TEMPLATE(BM_MapFind, uuid_flat_map<size_t>)->Arg(100000);
+
+BENCHMARK(BM_StdFind)->Arg(1000);
+BENCHMARK(BM_UuidIndexOf)->Arg(1000);
+BENCHMARK(BM_UuidIndexOfMultiple)->Arg(1000);
+
+BENCHMARK(BM_MemcpyUuids)->Arg(1 << 20);
+BENCHMARK(BM_ColumnDecode)->Arg(1 << 20);
+BENCHMARK(BM_ColumnAt)->Arg(1 << 20);
+
+BENCHMARK(BM_SortedVectorLowerBound)->Arg(1 << 23);
+BENCHMARK(BM_IndexFileFind)->Arg(1 << 23);
+BENCHMARK(BM_IndexFileFindBatch)->Arg(1 << 23);
+
+BENCHMARK_TEMPLATE(BM_Sort, std_sort)->Name("Sort std::sort")->Arg(1000000)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_Sort, radix_sort)->Name("Sort uuid_sort")->Arg(1000000)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_Sort, radix_sort_parallel)->Name("Sort uuid_sort_parallel")->Arg(1000000)->Unit(benchmark::kMillisecond)->UseRealTime();
+
+BENCHMARK(BM_create_span_dedicated_counter)->Arg(4096);
+BENCHMARK(BM_create_span_rolling_counter)->Arg(4096);
+BENCHMARK(BM_create_span_monotonic_counter)->Arg(100000);
+BENCHMARK(BM_create_span_monotonic_counter)->Arg(10000000);
+BENCHMARK(BM_create_span_random_increment)->Arg(100000)->Arg(10000000);
+
 // BENCHMARK(BM_create_batch_dedicated_counter)->Arg(256);
 // BENCHMARK(BM_create_batch_dedicated_counter)->Arg(1024);
 // BENCHMARK(BM_create_batch_dedicated_counter)->Arg(4096);
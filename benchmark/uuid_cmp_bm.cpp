@@ -1,37 +1,63 @@
 /**
-* Benchmarks comparing different implementation ideas of the < operator for uuid.
+* Benchmarks comparing different implementation ideas of the <=> operator for uuid.
  */
+#include <bit>
 #include <immintrin.h>
-#include <uuid.h>
-#include <uuid_factory.h>
+#include <random>
+#include <uuid.hpp>
+#include <uuid_factory.hpp>
 #include <benchmark/benchmark.h>
 
 using namespace LambdaSnail::Uuid;
 
-bool simple_loop_lt(uuid const &a, uuid const &b)
+static uuid_factory<std::mt19937_64> cmp_factory;
+
+std::strong_ordering simple_loop_cmp(uuid const &a, uuid const &b)
 {
     for (uint8_t i = 0; i < 16; ++i)
     {
-        if (a.octets[i] < b.octets[i]) return true;
+        if (a.octets[i] != b.octets[i]) return a.octets[i] <=> b.octets[i];
     }
 
-    return false;
+    return std::strong_ordering::equal;
+}
+
+std::strong_ordering simd_movemask_cmp(uuid const &a, uuid const &b)
+{
+    __m128i const this_id = _mm_load_si128(reinterpret_cast<__m128i const*>(a.octets.data()));
+    __m128i const other_id = _mm_load_si128(reinterpret_cast<__m128i const*>(b.octets.data()));
+
+    // The first differing octet decides, or octet 15 if they are all equal (which then compares equal)
+    uint32_t const diff = ~static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(this_id, other_id))) | (1u << 15);
+    int const index = std::countr_zero(diff);
+
+    return a.octets[index] <=> b.octets[index];
 }
 
-bool simd_lt(uuid const &a, uuid const &b)
+std::strong_ordering byte_swapped_cmp(uuid const &a, uuid const &b)
 {
-    __m128i const this_id = _mm_loadu_si128(reinterpret_cast<__m128i const*>(a.octets.data()));
-    __m128i const other_id = _mm_loadu_si128(reinterpret_cast<__m128i const*>(b.octets.data()));
+    uint64_t const a_hi = detail::load_big_endian(a.octets.data());
+    uint64_t const b_hi = detail::load_big_endian(b.octets.data());
+    uint64_t const a_lo = detail::load_big_endian(a.octets.data() + 8);
+    uint64_t const b_lo = detail::load_big_endian(b.octets.data() + 8);
 
-    __m128i const max = _mm_cmpeq_epi8(_mm_max_epu8(this_id, other_id), this_id);
-    return not _mm_test_all_ones(max);
+    bool const hi_equal = a_hi == b_hi;
+    return (hi_equal ? a_lo : a_hi) <=> (hi_equal ? b_lo : b_hi);
 }
 
-template <bool (*F)(uuid const& a, uuid const& b)>
-static void BM_cmp_lt(benchmark::State& state) {
+std::strong_ordering operator_cmp(uuid const &a, uuid const &b)
+{
+    return a <=> b;
+}
+
+template <std::strong_ordering (*F)(uuid const& a, uuid const& b)>
+static void BM_cmp_three_way(benchmark::State& state) {
     uuid id1, id2;
-    factory::create_uuid_v4(id1);
-    factory::create_uuid_v4(id2);
+    cmp_factory.create_uuid_v4(id1);
+    cmp_factory.create_uuid_v4(id2);
+
+    // Make the ids share a prefix of the given length, so the first difference moves around
+    std::copy_n(id1.octets.begin(), state.range(0), id2.octets.begin());
 
     for (auto _ : state)
     {
@@ -39,5 +65,7 @@ static void BM_cmp_lt(benchmark::State& state) {
     }
 }
 
-//BENCHMARK_TEMPLATE(BM_cmp_lt, simple_loop_lt)->Name("(<) Simple Loop")->Repetitions(100);
-//BENCHMARK_TEMPLATE(BM_cmp_lt, simd_lt)->Name("(<) SIMD")->Repetitions(100);
\ No newline at end of file
+BENCHMARK_TEMPLATE(BM_cmp_three_way, simple_loop_cmp)->Name("(<=>) Simple Loop")->Arg(0)->Arg(8)->Arg(15);
+BENCHMARK_TEMPLATE(BM_cmp_three_way, simd_movemask_cmp)->Name("(<=>) SIMD Movemask")->Arg(0)->Arg(8)->Arg(15);
+BENCHMARK_TEMPLATE(BM_cmp_three_way, byte_swapped_cmp)->Name("(<=>) Byte-swapped 64-bit")->Arg(0)->Arg(8)->Arg(15);
+BENCHMARK_TEMPLATE(BM_cmp_three_way, operator_cmp)->Name("(<=>) uuid::operator<=>")->Arg(0)->Arg(8)->Arg(15);
@@ -2,12 +2,15 @@
  * Benchmarks comparing different implementation ideas of the == operator for uuid.
  */
 #include <immintrin.h>
-#include <uuid.h>
-#include <uuid_factory.h>
+#include <random>
+#include <uuid.hpp>
+#include <uuid_factory.hpp>
 #include <benchmark/benchmark.h>
 
 using namespace LambdaSnail::Uuid;
 
+static uuid_factory<std::mt19937_64> equality_factory;
+
 bool simple_loop(uuid const& a, uuid const& b)
 {
     for(uint8_t i = 0; i < 16; ++i)
@@ -58,7 +61,7 @@ bool loop_unrolled_xor(uuid const& a, uuid const& b)
         (a.octets[15] ^ b.octets[15]);
 }
 
-bool simd(uuid const& a, uuid const& b)
+UUID_LIB_TARGET("sse4.1") bool simd(uuid const& a, uuid const& b)
 {
      __m128i const this_id = _mm_load_si128(reinterpret_cast<__m128i const*>(a.octets.data()));
      __m128i const other_id = _mm_load_si128(reinterpret_cast<__m128i const*>(b.octets.data()));
@@ -78,7 +81,7 @@ enum class cmp_test_case
 template <bool (*F)(uuid const& a, uuid const& b)>
 static void BM_cmp_eq(benchmark::State& state) {
     uuid id1, id2;
-    factory::create_uuid_v4(id1);
+    equality_factory.create_uuid_v4(id1);
     id2 = id1;
 
     for (auto _ : state)
@@ -90,8 +93,8 @@ static void BM_cmp_eq(benchmark::State& state) {
 template <bool (*F)(uuid const& a, uuid const& b)>
 static void BM_cmp_ne(benchmark::State& state) {
     uuid id1, id2;
-    factory::create_uuid_v4(id1);
-    factory::create_uuid_v4(id2);
+    equality_factory.create_uuid_v4(id1);
+    equality_factory.create_uuid_v4(id2);
 
     for (auto _ : state)
     {
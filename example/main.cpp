@@ -42,6 +42,9 @@ int main()
     std::cout << std::format("formatted: {}", uuid1) << std::endl;   // Without braces
     std::cout << std::format("formatted: {:#}", uuid1) << std::endl; // With braces
     std::cout << std::format("formatted: {:u}", uuid1) << std::endl;   // Upper case
+    std::cout << std::format("formatted: {:#u}", uuid1) << std::endl;  // Upper case with braces
+    std::cout << std::format("formatted: {:n}", uuid1) << std::endl;   // Without dashes
+    std::cout << std::format("formatted: {:r}", uuid1) << std::endl;   // With the urn:uuid: prefix
 
     // Some basic facts about the uuid structure
     static_assert(not std::is_trivially_constructible_v<uuid>);
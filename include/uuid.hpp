@@ -1,14 +1,20 @@
 #pragma once
 
 #include <array>
+#include <bit>
+#include <charconv>
+#include <compare>
 #include <cstdint>
-#include <format>
-#include <string>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <span>
 #include <string>
+#include <string_view>
+#include <system_error>
 
-#ifdef UUID_LIB_USE_SIMD
-#include <immintrin.h>
-#endif
+#include "uuid_cpu.hpp"
+#include "uuid_encoding.hpp"
 
 namespace LambdaSnail::Uuid
 {
@@ -20,9 +26,45 @@ namespace LambdaSnail::Uuid
     {
         standard,
         curly_braces,
-        no_dash
+        no_dash,
+
+        /**
+         * The 16 octets in the URL and filename safe base64 alphabet of RFC 4648, without padding (22 characters).
+         */
+        base64url,
+
+        /**
+         * The octets as a number in Douglas Crockford's base32 alphabet (26 characters, as in ULIDs). The text sorts
+         * like the octets, so v7 uuids keep their time order. Lower case and the aliases I, L (for 1) and O (for 0)
+         * are accepted when parsing.
+         */
+        base32,
+
+        /**
+         * The octets as a number in the base58 alphabet of bitcoin, padded to 22 characters with leading '1's. The
+         * text sorts like the octets.
+         */
+        base58
     };
 
+    /**
+     * The number of characters in the string representation of a uuid for each conversion mode. This is the size
+     * of the buffer needed by to_chars.
+     */
+    template<string_conversion_mode M>
+    inline constexpr size_t string_length = []
+    {
+        switch (M)
+        {
+            case string_conversion_mode::curly_braces: return 38;
+            case string_conversion_mode::no_dash: return 32;
+            case string_conversion_mode::base64url: return 22;
+            case string_conversion_mode::base32: return 26;
+            case string_conversion_mode::base58: return 22;
+            default: return 36;
+        }
+    }();
+
     /**
      * The UUID class really only holds octet data. Different versions of UUID are constructed using the provided factory functions.
      * The "raw" octet data is exposed to the user, so it should be relatively straightforward to implement a new UUID version. Thus,
@@ -57,14 +99,30 @@ namespace LambdaSnail::Uuid
         explicit uuid(uint8_t constant);
 
         bool operator==(const uuid&) const;
-        bool operator<(const uuid&) const;
 
         /**
-         * Returns a string representation of the UUID.
+         * Orders uuids by their octets, most significant octet first, as specified in the RFC. This is also the
+         * order of the timestamps of v7 uuids. The comparison is branch-free.
+         */
+        std::strong_ordering operator<=>(const uuid&) const noexcept;
+
+        /**
+         * Returns a string representation of the UUID. This allocates a new string for each call, see to_chars for
+         * a version that writes into a caller-supplied buffer.
          */
         template<string_conversion_mode M = string_conversion_mode::standard>
         [[nodiscard]] std::string as_string() const;
 
+        /**
+         * Parses a uuid from its string representation. The whole string must match the layout given by the
+         * conversion mode, but the hex digits may be either upper or lower case. No exceptions are thrown.
+         * @param str The string to parse.
+         * @param out_id The output uuid. This is left untouched if the string could not be parsed.
+         * @return A value initialized std::errc on success, otherwise std::errc::invalid_argument.
+         */
+        template<string_conversion_mode M = string_conversion_mode::standard>
+        [[nodiscard]] static std::errc from_string(std::string_view str, uuid& out_id) noexcept;
+
         /**
          * The empty or nil UUID, with all octets set to 0.
          */
@@ -79,12 +137,42 @@ namespace LambdaSnail::Uuid
         octet_set_t octets{};
     };
 
-    uuid const uuid::nil = uuid( 0x00 );
-    uuid const uuid::max = uuid( 0xFF );
+    /**
+     * Parses a uuid from the beginning of the character range [first, last), in the same manner as std::from_chars.
+     * Characters following the uuid are not examined, so this can be used to read ids embedded in a larger text.
+     * @param first The beginning of the range to parse.
+     * @param last One past the end of the range to parse.
+     * @param out_id The output uuid. This is left untouched if parsing fails.
+     * @return On success, ptr points to the first character after the uuid and ec is value initialized. On failure,
+     * ptr equals first and ec is std::errc::invalid_argument.
+     */
+    template<string_conversion_mode M = string_conversion_mode::standard>
+    std::from_chars_result from_chars(char const* first, char const* last, uuid& out_id) noexcept;
+
+    /**
+     * Writes the string representation of a uuid into the character range [first, last), in the same manner as
+     * std::to_chars. No allocations are made and no null terminator is written.
+     * @param first The beginning of the output range.
+     * @param last One past the end of the output range. The range must hold at least string_length<M> characters.
+     * @param id The uuid to convert.
+     * @return On success, ptr points one past the last character written and ec is value initialized. If the range is
+     * too small, ptr equals last and ec is std::errc::value_too_large.
+     */
+    template<string_conversion_mode M = string_conversion_mode::standard>
+    std::to_chars_result to_chars(char* first, char* last, uuid const& id) noexcept;
+
+    /**
+     * Writes the string representation of a uuid into the provided buffer. See the pointer overload for details.
+     */
+    template<string_conversion_mode M = string_conversion_mode::standard>
+    std::to_chars_result to_chars(std::span<char> out, uuid const& id) noexcept;
+
+    inline uuid const uuid::nil = uuid( 0x00 );
+    inline uuid const uuid::max = uuid( 0xFF );
 
-    uuid::uuid() : uuid( 0x00 ) {}
+    inline uuid::uuid() : uuid( 0x00 ) {}
 
-    uuid::uuid(uint8_t constant)
+    inline uuid::uuid(uint8_t constant)
     {
         octets.fill(constant);
     }
@@ -96,42 +184,81 @@ namespace LambdaSnail::Uuid
         __m128i const other_id = _mm_load_si128(reinterpret_cast<__m128i const*>(other.octets.data()));
 
         __m128i const tmp = _mm_cmpeq_epi8( this_id, other_id );
-        return _mm_test_all_ones(tmp);
-#elif
-        return m_octets[0] == other.m_octets[0] and
-        m_octets[1] == other.m_octets[1] and
-        m_octets[2] == other.m_octets[2] and
-        m_octets[3] == other.m_octets[3] and
-        m_octets[4] == other.m_octets[4] and
-        m_octets[5] == other.m_octets[5] and
-        m_octets[6] == other.m_octets[6] and
-        m_octets[7] == other.m_octets[7] and
-        m_octets[8] == other.m_octets[8] and
-        m_octets[9] == other.m_octets[9] and
-        m_octets[10] == other.m_octets[10] and
-        m_octets[11] == other.m_octets[11] and
-        m_octets[12] == other.m_octets[12] and
-        m_octets[13] == other.m_octets[13] and
-        m_octets[14] == other.m_octets[14] and
-        m_octets[15] == other.m_octets[15];
+        return _mm_movemask_epi8(tmp) == 0xFFFF;
+#else
+        uint64_t this_lo, this_hi, other_lo, other_hi;
+        memcpy(&this_lo, octets.data(), sizeof(uint64_t));
+        memcpy(&this_hi, octets.data() + 8, sizeof(uint64_t));
+        memcpy(&other_lo, other.octets.data(), sizeof(uint64_t));
+        memcpy(&other_hi, other.octets.data() + 8, sizeof(uint64_t));
+
+        return ((this_lo ^ other_lo) | (this_hi ^ other_hi)) == 0;
 #endif
     }
 
-    inline bool uuid::operator<(const uuid& other) const
+    namespace detail
     {
-#ifdef UUID_LIB_USE_SIMD
-        __m128i const this_id = _mm_loadu_si128(reinterpret_cast<__m128i const*>(this->octets.data()));
-        __m128i const other_id = _mm_loadu_si128(reinterpret_cast<__m128i const*>(other.octets.data()));
+        /**
+         * Loads eight octets as a big endian integer, so that integer comparison matches the octet order.
+         */
+        inline uint64_t load_big_endian(uint8_t const* octets) noexcept
+        {
+            uint64_t value;
+            memcpy(&value, octets, sizeof(uint64_t));
 
-        __m128i const cmp_max = _mm_cmpeq_epi8(_mm_max_epu8(this_id, other_id), this_id);
-        return not _mm_test_all_ones(cmp_max);
+            if constexpr (std::endian::native == std::endian::little)
+            {
+#ifdef _MSC_VER
+                value = _byteswap_uint64(value);
 #else
-        for (uint8_t i = 0; i < 16; ++i)
+                value = __builtin_bswap64(value);
+#endif
+            }
+
+            return value;
+        }
+
+        /**
+         * Stores an integer as eight big endian octets, the inverse of load_big_endian.
+         */
+        inline void store_big_endian(uint8_t* octets, uint64_t value) noexcept
         {
-            if (a.m_octets[i] < b.m_octets[i]) return true;
+            if constexpr (std::endian::native == std::endian::little)
+            {
+#ifdef _MSC_VER
+                value = _byteswap_uint64(value);
+#else
+                value = __builtin_bswap64(value);
+#endif
+            }
+
+            memcpy(octets, &value, sizeof(uint64_t));
         }
+    }
+
+    inline std::strong_ordering uuid::operator<=>(const uuid& other) const noexcept
+    {
+#ifdef UUID_LIB_USE_SIMD
+        __m128i const this_id = _mm_load_si128(reinterpret_cast<__m128i const*>(octets.data()));
+        __m128i const other_id = _mm_load_si128(reinterpret_cast<__m128i const*>(other.octets.data()));
 
-        return false;
+        // The first differing octet decides. If all octets are equal, octet 15 is picked and compares equal
+        uint32_t const diff = ~static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(this_id, other_id))) | (1u << 15);
+        int const index = std::countr_zero(diff);
+
+        return octets[index] <=> other.octets[index];
+#else
+        uint64_t const this_hi = detail::load_big_endian(octets.data());
+        uint64_t const other_hi = detail::load_big_endian(other.octets.data());
+        uint64_t const this_lo = detail::load_big_endian(octets.data() + 8);
+        uint64_t const other_lo = detail::load_big_endian(other.octets.data() + 8);
+
+        // The low halves only decide when the high halves are equal. The selects compile to conditional moves
+        bool const hi_equal = this_hi == other_hi;
+        uint64_t const this_key = hi_equal ? this_lo : this_hi;
+        uint64_t const other_key = hi_equal ? other_lo : other_hi;
+
+        return this_key <=> other_key;
 #endif
     }
 
@@ -143,26 +270,443 @@ namespace LambdaSnail::Uuid
     template<string_conversion_mode Mode>
     inline std::string uuid::as_string() const
     {
-        auto format_resolver = [](string_conversion_mode m) consteval
-        {
-            switch(m)
-            {
-                case string_conversion_mode::curly_braces:
-                    return "{{{:02x}{:02x}{:02x}{:02x}-{:02x}{:02x}-{:02x}{:02x}-{:02x}{:02x}-{:02x}{:02x}{:02x}{:02x}{:02x}{:02x}}}";
-                case string_conversion_mode::no_dash:
-                    return "{:02x}{:02x}{:02x}{:02x}{:02x}{:02x}{:02x}{:02x}{:02x}{:02x}{:02x}{:02x}{:02x}{:02x}{:02x}{:02x}";
-                case string_conversion_mode::standard:
-                    return "{:02x}{:02x}{:02x}{:02x}-{:02x}{:02x}-{:02x}{:02x}-{:02x}{:02x}-{:02x}{:02x}{:02x}{:02x}{:02x}{:02x}";
-            }
-        };
-
-        return std::format(
-                format_resolver(Mode),
-                octets[0], octets[1], octets[2], octets[3],
-                octets[4], octets[5],
-                octets[6], octets[7],
-                octets[8], octets[9],
-                octets[10], octets[11], octets[12], octets[13], octets[14], octets[15]
-        );
+        std::string result(string_length<Mode>, '\0');
+        to_chars<Mode>(result.data(), result.data() + result.size(), *this);
+        return result;
+    }
+
+    namespace detail
+    {
+        /**
+         * Maps an ascii hex digit to its value, or to 0xFF if the character is not a hex digit.
+         */
+        constexpr uint8_t hex_value(char c) noexcept
+        {
+            if (c >= '0' and c <= '9') return c - '0';
+            if (c >= 'a' and c <= 'f') return c - 'a' + 10;
+            if (c >= 'A' and c <= 'F') return c - 'A' + 10;
+            return 0xFF;
+        }
+
+        /**
+         * Offset of the first hex digit of each octet in the standard layout.
+         */
+        inline constexpr std::array<uint8_t, 16> s_standard_hex_offsets = { 0, 2, 4, 6, 9, 11, 14, 16, 19, 21, 24, 26, 28, 30, 32, 34 };
+
+        inline bool has_standard_dashes(char const* str) noexcept
+        {
+            return (str[8] == '-') & (str[13] == '-') & (str[18] == '-') & (str[23] == '-');
+        }
+
+        template<string_conversion_mode M>
+        bool parse_octets_scalar(char const* str, uint8_t* out) noexcept
+        {
+            uint8_t invalid = 0;
+            for (size_t i = 0; i < 16; ++i)
+            {
+                size_t const offset = M == string_conversion_mode::no_dash ? 2 * i : s_standard_hex_offsets[i];
+                uint8_t const hi = hex_value(str[offset]);
+                uint8_t const lo = hex_value(str[offset + 1]);
+
+                invalid |= hi | lo;
+                out[i] = static_cast<uint8_t>(hi << 4) | (lo & 0x0F);
+            }
+
+            return (invalid & 0xF0) == 0;
+        }
+
+#ifdef UUID_LIB_USE_SIMD
+        /**
+         * Converts 16 ascii hex digits into their nibble values. Lanes that do not hold a hex digit are flagged
+         * with 0xFF in the returned validity mask.
+         */
+        UUID_LIB_TARGET("ssse3") inline __m128i hex_to_nibbles(__m128i chars, __m128i& invalid) noexcept
+        {
+            __m128i const digits = _mm_sub_epi8(chars, _mm_set1_epi8('0'));
+            __m128i const letters = _mm_sub_epi8(_mm_or_si128(chars, _mm_set1_epi8(0x20)), _mm_set1_epi8('a'));
+
+            __m128i const is_digit = _mm_cmpeq_epi8(_mm_min_epu8(digits, _mm_set1_epi8(9)), digits);
+            __m128i const is_letter = _mm_cmpeq_epi8(_mm_min_epu8(letters, _mm_set1_epi8(5)), letters);
+
+            invalid = _mm_or_si128(invalid, _mm_andnot_si128(_mm_or_si128(is_digit, is_letter), _mm_set1_epi8(-1)));
+
+            return _mm_or_si128(
+                _mm_and_si128(is_digit, digits),
+                _mm_and_si128(is_letter, _mm_add_epi8(letters, _mm_set1_epi8(10))));
+        }
+
+        /**
+         * Decodes 32 contiguous hex digits, split over two registers, into 16 octets. Validation and decoding
+         * happen in the same pass, and the octets are only meaningful if the function returns true.
+         */
+        UUID_LIB_TARGET("ssse3") inline bool decode_hex_ssse3(__m128i lo_chars, __m128i hi_chars, uint8_t* out) noexcept
+        {
+            __m128i invalid = _mm_setzero_si128();
+            __m128i const lo = hex_to_nibbles(lo_chars, invalid);
+            __m128i const hi = hex_to_nibbles(hi_chars, invalid);
+
+            // Each pair of nibbles becomes one 16-bit lane holding (first << 4) | second
+            __m128i const weights = _mm_set1_epi16(0x0110);
+            __m128i const octets = _mm_packus_epi16(_mm_maddubs_epi16(lo, weights), _mm_maddubs_epi16(hi, weights));
+
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(out), octets);
+            return _mm_movemask_epi8(invalid) == 0;
+        }
+
+        UUID_LIB_TARGET("avx2") inline bool decode_hex_avx2(__m256i chars, uint8_t* out) noexcept
+        {
+            __m256i const digits = _mm256_sub_epi8(chars, _mm256_set1_epi8('0'));
+            __m256i const letters = _mm256_sub_epi8(_mm256_or_si256(chars, _mm256_set1_epi8(0x20)), _mm256_set1_epi8('a'));
+
+            __m256i const is_digit = _mm256_cmpeq_epi8(_mm256_min_epu8(digits, _mm256_set1_epi8(9)), digits);
+            __m256i const is_letter = _mm256_cmpeq_epi8(_mm256_min_epu8(letters, _mm256_set1_epi8(5)), letters);
+
+            __m256i const nibbles = _mm256_or_si256(
+                _mm256_and_si256(is_digit, digits),
+                _mm256_and_si256(is_letter, _mm256_add_epi8(letters, _mm256_set1_epi8(10))));
+
+            __m256i const pairs = _mm256_maddubs_epi16(nibbles, _mm256_set1_epi16(0x0110));
+            __m128i const octets = _mm_packus_epi16(_mm256_castsi256_si128(pairs), _mm256_extracti128_si256(pairs, 1));
+
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(out), octets);
+            return static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_or_si256(is_digit, is_letter))) == 0xFFFFFFFF;
+        }
+
+        /**
+         * Gathers the 32 hex digits of the standard layout into two registers, dropping the dashes.
+         */
+        UUID_LIB_TARGET("ssse3") inline void compact_standard_ssse3(char const* str, __m128i& lo_chars, __m128i& hi_chars) noexcept
+        {
+            uint32_t head;
+            memcpy(&head, str, sizeof(uint32_t));
+
+            // Characters 4-19 hold hex digits 4-15, with dashes at 8 and 13
+            __m128i const mid = _mm_loadu_si128(reinterpret_cast<__m128i const*>(str + 4));
+            lo_chars = _mm_or_si128(
+                _mm_shuffle_epi8(mid, _mm_setr_epi8(-1, -1, -1, -1, 0, 1, 2, 3, 5, 6, 7, 8, 10, 11, 12, 13)),
+                _mm_cvtsi32_si128(static_cast<int>(head)));
+
+            // Characters 20-35 hold hex digits 17-31, with a dash at 23. Digit 16 is character 19
+            __m128i const tail = _mm_loadu_si128(reinterpret_cast<__m128i const*>(str + 20));
+            hi_chars = _mm_or_si128(
+                _mm_shuffle_epi8(tail, _mm_setr_epi8(-1, 0, 1, 2, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15)),
+                _mm_cvtsi32_si128(static_cast<uint8_t>(str[19])));
+        }
+
+        template<string_conversion_mode M>
+        UUID_LIB_TARGET("ssse3") bool parse_octets_ssse3(char const* str, uint8_t* out) noexcept
+        {
+            if constexpr (M == string_conversion_mode::no_dash)
+            {
+                return decode_hex_ssse3(
+                    _mm_loadu_si128(reinterpret_cast<__m128i const*>(str)),
+                    _mm_loadu_si128(reinterpret_cast<__m128i const*>(str + 16)), out);
+            }
+            else
+            {
+                __m128i lo_chars, hi_chars;
+                compact_standard_ssse3(str, lo_chars, hi_chars);
+                return decode_hex_ssse3(lo_chars, hi_chars, out) & has_standard_dashes(str);
+            }
+        }
+
+        template<string_conversion_mode M>
+        UUID_LIB_TARGET("avx2") bool parse_octets_avx2(char const* str, uint8_t* out) noexcept
+        {
+            if constexpr (M == string_conversion_mode::no_dash)
+            {
+                return decode_hex_avx2(_mm256_loadu_si256(reinterpret_cast<__m256i const*>(str)), out);
+            }
+            else
+            {
+                __m128i lo_chars, hi_chars;
+                compact_standard_ssse3(str, lo_chars, hi_chars);
+                return decode_hex_avx2(_mm256_set_m128i(hi_chars, lo_chars), out) & has_standard_dashes(str);
+            }
+        }
+#endif
+
+        /**
+         * True for the layouts made of hex digits: standard, curly_braces and no_dash.
+         */
+        template<string_conversion_mode M>
+        inline constexpr bool is_hex_mode = M == string_conversion_mode::standard or M == string_conversion_mode::curly_braces or M == string_conversion_mode::no_dash;
+
+        template<string_conversion_mode M>
+        bool parse_hex_octets(char const* str, uint8_t* out) noexcept
+        {
+#ifdef UUID_LIB_USE_SIMD
+            if (has_avx2())
+            {
+                return parse_octets_avx2<M>(str, out);
+            }
+
+            if (has_ssse3())
+            {
+                return parse_octets_ssse3<M>(str, out);
+            }
+#endif
+            if constexpr (M == string_conversion_mode::no_dash)
+            {
+                return parse_octets_scalar<M>(str, out);
+            }
+            else
+            {
+                return parse_octets_scalar<M>(str, out) & has_standard_dashes(str);
+            }
+        }
+
+        /**
+         * Parses the octets of a uuid from a string with the layout of the given mode. For curly braces the
+         * string should point at the first character after the opening brace.
+         */
+        template<string_conversion_mode M>
+        bool parse_octets(char const* str, uint8_t* out) noexcept
+        {
+            if constexpr (M == string_conversion_mode::base64url)
+            {
+                return decode_base64url(str, out);
+            }
+            else if constexpr (M == string_conversion_mode::base32)
+            {
+                return decode_base32(str, out);
+            }
+            else if constexpr (M == string_conversion_mode::base58)
+            {
+                return decode_base58(str, out);
+            }
+            else
+            {
+                return parse_hex_octets<M>(str, out);
+            }
+        }
+
+        inline constexpr char s_hex_digits_lower[] = "0123456789abcdef";
+        inline constexpr char s_hex_digits_upper[] = "0123456789ABCDEF";
+
+        /**
+         * Writes the standard layout, starting at the first hex digit. Used by the scalar path only.
+         */
+        inline void format_standard_scalar(uint8_t const* octets, char* out, char const* digits) noexcept
+        {
+            for (size_t i = 0; i < 16; ++i)
+            {
+                out[s_standard_hex_offsets[i]] = digits[octets[i] >> 4];
+                out[s_standard_hex_offsets[i] + 1] = digits[octets[i] & 0x0F];
+            }
+
+            out[8] = out[13] = out[18] = out[23] = '-';
+        }
+
+#ifdef UUID_LIB_USE_SIMD
+        /**
+         * Converts 16 octets into 32 hex digits. The low register holds the digits of octets 0-7, the high register
+         * those of octets 8-15.
+         */
+        UUID_LIB_TARGET("ssse3") inline void octets_to_hex_ssse3(__m128i octets, __m128i& lo_chars, __m128i& hi_chars, bool upper_case) noexcept
+        {
+            __m128i const table = _mm_loadu_si128(reinterpret_cast<__m128i const*>(
+                upper_case ? s_hex_digits_upper : s_hex_digits_lower));
+
+            __m128i const mask = _mm_set1_epi8(0x0F);
+            __m128i const hi_nibbles = _mm_shuffle_epi8(table, _mm_and_si128(_mm_srli_epi16(octets, 4), mask));
+            __m128i const lo_nibbles = _mm_shuffle_epi8(table, _mm_and_si128(octets, mask));
+
+            lo_chars = _mm_unpacklo_epi8(hi_nibbles, lo_nibbles);
+            hi_chars = _mm_unpackhi_epi8(hi_nibbles, lo_nibbles);
+        }
+
+        /**
+         * Writes the 36 characters of the standard layout, spreading the hex digits out with shuffles and
+         * inserting the dashes in the gaps.
+         */
+        UUID_LIB_TARGET("ssse3") inline void store_standard_ssse3(__m128i lo_chars, __m128i hi_chars, char* out) noexcept
+        {
+            // Characters 0-15: digits 0-7, dash, digits 8-11, dash, digits 12-13
+            __m128i const first = _mm_or_si128(
+                _mm_shuffle_epi8(lo_chars, _mm_setr_epi8(0, 1, 2, 3, 4, 5, 6, 7, -1, 8, 9, 10, 11, -1, 12, 13)),
+                _mm_setr_epi8(0, 0, 0, 0, 0, 0, 0, 0, '-', 0, 0, 0, 0, '-', 0, 0));
+
+            // Characters 16-31: digits 14-15, dash, digits 16-19, dash, digits 20-27
+            __m128i const second = _mm_or_si128(
+                _mm_or_si128(
+                    _mm_shuffle_epi8(lo_chars, _mm_setr_epi8(14, 15, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1)),
+                    _mm_shuffle_epi8(hi_chars, _mm_setr_epi8(-1, -1, -1, 0, 1, 2, 3, -1, 4, 5, 6, 7, 8, 9, 10, 11))),
+                _mm_setr_epi8(0, 0, '-', 0, 0, 0, 0, '-', 0, 0, 0, 0, 0, 0, 0, 0));
+
+            // Characters 32-35: digits 28-31
+            uint32_t const last = static_cast<uint32_t>(_mm_cvtsi128_si32(_mm_srli_si128(hi_chars, 12)));
+
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(out), first);
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(out + 16), second);
+            memcpy(out + 32, &last, sizeof(uint32_t));
+        }
+
+        /**
+         * Writes the hex digits of the octets, with dashes unless the mode is no_dash. Braces are left to the caller.
+         */
+        template<string_conversion_mode M>
+        UUID_LIB_TARGET("ssse3") void format_octets_ssse3(uint8_t const* octets, char* out, bool upper_case) noexcept
+        {
+            __m128i lo_chars, hi_chars;
+            octets_to_hex_ssse3(_mm_loadu_si128(reinterpret_cast<__m128i const*>(octets)), lo_chars, hi_chars, upper_case);
+
+            if constexpr (M == string_conversion_mode::no_dash)
+            {
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(out), lo_chars);
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(out + 16), hi_chars);
+            }
+            else
+            {
+                store_standard_ssse3(lo_chars, hi_chars, out);
+            }
+        }
+#endif
+
+        template<string_conversion_mode M>
+        void format_octets_scalar(uint8_t const* octets, char* out, bool upper_case) noexcept
+        {
+            char const* digits = upper_case ? s_hex_digits_upper : s_hex_digits_lower;
+            if constexpr (M == string_conversion_mode::no_dash)
+            {
+                for (size_t i = 0; i < 16; ++i)
+                {
+                    out[2 * i] = digits[octets[i] >> 4];
+                    out[2 * i + 1] = digits[octets[i] & 0x0F];
+                }
+            }
+            else
+            {
+                format_standard_scalar(octets, out, digits);
+            }
+        }
+
+        /**
+         * Writes the hex digits of the octets in one of the hex layouts, including the braces for curly_braces.
+         */
+        template<string_conversion_mode M>
+        void format_hex_octets(uint8_t const* octets, char* out, bool upper_case) noexcept
+        {
+            if constexpr (M == string_conversion_mode::curly_braces)
+            {
+                out[0] = '{';
+                out[string_length<M> - 1] = '}';
+                ++out;
+            }
+
+#ifdef UUID_LIB_USE_SIMD
+            if (has_ssse3())
+            {
+                format_octets_ssse3<M>(octets, out, upper_case);
+                return;
+            }
+#endif
+            format_octets_scalar<M>(octets, out, upper_case);
+        }
+
+        /**
+         * Writes the string representation of the octets in the layout of the given mode. The output must have room
+         * for string_length<M> characters. The compact encodings have a single case, so upper_case only applies to
+         * the hex layouts.
+         */
+        template<string_conversion_mode M>
+        void format_octets(uint8_t const* octets, char* out, bool upper_case) noexcept
+        {
+            if constexpr (M == string_conversion_mode::base64url)
+            {
+                encode_base64url(octets, out);
+            }
+            else if constexpr (M == string_conversion_mode::base32)
+            {
+                encode_base32(octets, out);
+            }
+            else if constexpr (M == string_conversion_mode::base58)
+            {
+                encode_base58(octets, out);
+            }
+            else
+            {
+                format_hex_octets<M>(octets, out, upper_case);
+            }
+        }
+    }
+
+    template<string_conversion_mode Mode>
+    std::to_chars_result to_chars(char* first, char* last, uuid const& id) noexcept
+    {
+        size_t constexpr length = string_length<Mode>;
+        if (last - first < static_cast<ptrdiff_t>(length))
+        {
+            return { last, std::errc::value_too_large };
+        }
+
+        detail::format_octets<Mode>(id.octets.data(), first, false);
+        return { first + length, std::errc{} };
+    }
+
+    template<string_conversion_mode Mode>
+    std::to_chars_result to_chars(std::span<char> out, uuid const& id) noexcept
+    {
+        return to_chars<Mode>(out.data(), out.data() + out.size(), id);
+    }
+
+    template<string_conversion_mode Mode>
+    std::from_chars_result from_chars(char const* first, char const* last, uuid& out_id) noexcept
+    {
+        size_t constexpr length = string_length<Mode>;
+        if (last - first < static_cast<ptrdiff_t>(length))
+        {
+            return { first, std::errc::invalid_argument };
+        }
+
+        char const* hex_begin = first;
+        if constexpr (Mode == string_conversion_mode::curly_braces)
+        {
+            if (first[0] != '{' or first[length - 1] != '}')
+            {
+                return { first, std::errc::invalid_argument };
+            }
+
+            ++hex_begin;
+        }
+
+        alignas(16) uuid::octet_set_t octets;
+        if (not detail::parse_octets<Mode>(hex_begin, octets.data()))
+        {
+            return { first, std::errc::invalid_argument };
+        }
+
+        out_id.octets = octets;
+        return { first + length, std::errc{} };
+    }
+
+    template<string_conversion_mode Mode>
+    inline std::errc uuid::from_string(std::string_view str, uuid& out_id) noexcept
+    {
+        if (str.size() != string_length<Mode>)
+        {
+            return std::errc::invalid_argument;
+        }
+
+        return from_chars<Mode>(str.data(), str.data() + str.size(), out_id).ec;
     }
 }
+
+/**
+ * Hashes a uuid by folding its two 64-bit halves together with a single multiplicative mix. The random bits of v4
+ * and v7 are already well distributed, but the timestamp prefix of v7 (and uuids from other sources) is not, so the
+ * mix spreads every input bit across the whole result.
+ */
+template<>
+struct std::hash<LambdaSnail::Uuid::uuid>
+{
+    size_t operator()(LambdaSnail::Uuid::uuid const& id) const noexcept
+    {
+        uint64_t lo, hi;
+        memcpy(&lo, id.octets.data(), sizeof(uint64_t));
+        memcpy(&hi, id.octets.data() + sizeof(uint64_t), sizeof(uint64_t));
+
+        uint64_t const mixed = (lo ^ std::rotl(hi, 32)) * 0x9E3779B97F4A7C15ull;
+        return static_cast<size_t>(mixed ^ (mixed >> 32));
+    }
+};
@@ -1,5 +1,21 @@
 #pragma once
 
-#include "uuid.h"
-#include "uuid_factory.h"
-#include "uuid_format.h"
\ No newline at end of file
+#include "uuid.hpp"
+#include "uuid_bulk.hpp"
+#include "uuid_clock.hpp"
+#include "uuid_column.hpp"
+#include "uuid_concurrent.hpp"
+#include "uuid_cpu.hpp"
+#include "uuid_encoding.hpp"
+#include "uuid_factory.hpp"
+#include "uuid_flat_map.hpp"
+#include "uuid_format.hpp"
+#include "uuid_index.hpp"
+#include "uuid_name.hpp"
+#include "uuid_pool.hpp"
+#include "uuid_search.hpp"
+#include "uuid_sequencer.hpp"
+#include "uuid_sort.hpp"
+#include "uuid_v8.hpp"
+#include "uuid_view.hpp"
+#include "xoroshiro128.hpp"
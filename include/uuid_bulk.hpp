@@ -0,0 +1,313 @@
+#pragma once
+
+#include <charconv>
+#include <cstdint>
+#include <span>
+#include <string_view>
+#include <system_error>
+#include <vector>
+
+#include "uuid.hpp"
+
+namespace LambdaSnail::Uuid
+{
+    /**
+     * The number of characters needed to format a number of uuids with format_uuids, including one separator
+     * after each uuid.
+     */
+    template<string_conversion_mode M = string_conversion_mode::standard>
+    constexpr size_t bulk_string_length(size_t num_uuids) noexcept
+    {
+        return num_uuids * (string_length<M> + 1);
+    }
+
+    /**
+     * Formats a sequence of uuids into one contiguous text buffer, writing the separator after each uuid (including
+     * the last one). This is intended for exporting large numbers of uuids to e.g. CSV or NDJSON, and does not
+     * allocate or call any per-uuid functions.
+     *
+     * On cpus with AVX2, two uuids are converted per 256-bit register.
+     *
+     * @param ids The uuids to format.
+     * @param separator The character written after each uuid, e.g. '\n' or ','.
+     * @param first The beginning of the output range.
+     * @param last One past the end of the output range. The range must hold at least bulk_string_length<M>(ids.size()) characters.
+     * @return On success, ptr points one past the last character written and ec is value initialized. If the range is
+     * too small nothing is written, ptr equals last and ec is std::errc::value_too_large.
+     */
+    template<string_conversion_mode M = string_conversion_mode::standard>
+    std::to_chars_result format_uuids(std::span<uuid const> ids, char separator, char* first, char* last) noexcept;
+
+    /**
+     * Formats a sequence of uuids into the provided buffer. See the pointer overload for details.
+     */
+    template<string_conversion_mode M = string_conversion_mode::standard>
+    std::to_chars_result format_uuids(std::span<uuid const> ids, char separator, std::span<char> out) noexcept;
+
+    /**
+     * The result of parsing a text buffer with parse_uuids.
+     */
+    struct parse_uuids_result
+    {
+        /**
+         * The number of uuids written to the output.
+         */
+        size_t num_parsed;
+
+        /**
+         * On success, the size of the text. On failure, the byte offset of the first entry that could not be parsed
+         * or did not fit in the output.
+         */
+        size_t offset;
+
+        /**
+         * Value initialized on success, std::errc::invalid_argument for a malformed entry and
+         * std::errc::value_too_large if the output is full before the end of the text.
+         */
+        std::errc ec;
+    };
+
+    /**
+     * Parses a text buffer holding uuids separated by newlines and/or commas, such as a memory-mapped file, into
+     * preallocated storage. Runs of separators (e.g. CRLF line endings or a trailing newline) are skipped. Every entry
+     * must have the layout of the given mode, upper and lower case hex digits are both accepted.
+     *
+     * Since every entry has a fixed width, the separators are located directly from the layout rather than by
+     * searching, and each entry is decoded and validated with the same SIMD kernel as from_chars. Parsing stops at the
+     * first malformed entry.
+     *
+     * @param text The text to parse.
+     * @param out The storage to place the parsed uuids in. Only the first num_parsed uuids are written.
+     * @return The number of uuids parsed and, on failure, the byte offset of the offending entry.
+     */
+    template<string_conversion_mode M = string_conversion_mode::standard>
+    parse_uuids_result parse_uuids(std::string_view text, std::span<uuid> out) noexcept;
+
+    /**
+     * Parses a text buffer holding uuids separated by newlines and/or commas, appending them to the vector.
+     * See the span overload for details. On failure, the uuids parsed before the malformed entry are kept.
+     */
+    template<string_conversion_mode M = string_conversion_mode::standard>
+    parse_uuids_result parse_uuids(std::string_view text, std::vector<uuid>& out_vec);
+
+    namespace detail
+    {
+        constexpr bool is_uuid_separator(char c) noexcept
+        {
+            return c == '\n' or c == ',' or c == '\r';
+        }
+
+#ifdef UUID_LIB_USE_SIMD
+        /**
+         * Converts two uuids, one per 128-bit lane, into hex digits. In each lane the low register holds the digits
+         * of octets 0-7 and the high register those of octets 8-15.
+         */
+        UUID_LIB_TARGET("avx2") inline void octets_to_hex_avx2(__m256i octets, __m256i& lo_chars, __m256i& hi_chars) noexcept
+        {
+            __m256i const table = _mm256_broadcastsi128_si256(
+                _mm_loadu_si128(reinterpret_cast<__m128i const*>(s_hex_digits_lower)));
+
+            __m256i const mask = _mm256_set1_epi8(0x0F);
+            __m256i const hi_nibbles = _mm256_shuffle_epi8(table, _mm256_and_si256(_mm256_srli_epi16(octets, 4), mask));
+            __m256i const lo_nibbles = _mm256_shuffle_epi8(table, _mm256_and_si256(octets, mask));
+
+            lo_chars = _mm256_unpacklo_epi8(hi_nibbles, lo_nibbles);
+            hi_chars = _mm256_unpackhi_epi8(hi_nibbles, lo_nibbles);
+        }
+
+        /**
+         * Writes the two uuids held in the lanes of the registers, each followed by the separator.
+         * The output of the second uuid starts stride characters after the first.
+         */
+        template<string_conversion_mode M>
+        UUID_LIB_TARGET("avx2") void store_pair_avx2(__m256i lo_chars, __m256i hi_chars, char* out, char separator) noexcept
+        {
+            size_t constexpr stride = string_length<M> + 1;
+
+            if constexpr (M == string_conversion_mode::no_dash)
+            {
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(out), _mm256_castsi256_si128(lo_chars));
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(out + 16), _mm256_castsi256_si128(hi_chars));
+                out[32] = separator;
+
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(out + stride), _mm256_extracti128_si256(lo_chars, 1));
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(out + stride + 16), _mm256_extracti128_si256(hi_chars, 1));
+                out[stride + 32] = separator;
+            }
+            else
+            {
+                // Same shuffles as store_standard_ssse3, applied to both lanes at once
+                __m256i const first = _mm256_or_si256(
+                    _mm256_shuffle_epi8(lo_chars, _mm256_broadcastsi128_si256(
+                        _mm_setr_epi8(0, 1, 2, 3, 4, 5, 6, 7, -1, 8, 9, 10, 11, -1, 12, 13))),
+                    _mm256_broadcastsi128_si256(_mm_setr_epi8(0, 0, 0, 0, 0, 0, 0, 0, '-', 0, 0, 0, 0, '-', 0, 0)));
+
+                __m256i const second = _mm256_or_si256(
+                    _mm256_or_si256(
+                        _mm256_shuffle_epi8(lo_chars, _mm256_broadcastsi128_si256(
+                            _mm_setr_epi8(14, 15, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1))),
+                        _mm256_shuffle_epi8(hi_chars, _mm256_broadcastsi128_si256(
+                            _mm_setr_epi8(-1, -1, -1, 0, 1, 2, 3, -1, 4, 5, 6, 7, 8, 9, 10, 11)))),
+                    _mm256_broadcastsi128_si256(_mm_setr_epi8(0, 0, '-', 0, 0, 0, 0, '-', 0, 0, 0, 0, 0, 0, 0, 0)));
+
+                // Digits 28-31 of each uuid, followed by the separator
+                __m256i const tail = _mm256_or_si256(
+                    _mm256_srli_si256(hi_chars, 12),
+                    _mm256_set1_epi64x(static_cast<int64_t>(static_cast<uint8_t>(separator)) << 32));
+
+                size_t constexpr offset = M == string_conversion_mode::curly_braces ? 1 : 0;
+                for (size_t lane = 0; lane < 2; ++lane)
+                {
+                    char* const dst = out + lane * stride;
+                    __m128i const lane_first = lane == 0 ? _mm256_castsi256_si128(first) : _mm256_extracti128_si256(first, 1);
+                    __m128i const lane_second = lane == 0 ? _mm256_castsi256_si128(second) : _mm256_extracti128_si256(second, 1);
+                    __m128i const lane_tail = lane == 0 ? _mm256_castsi256_si128(tail) : _mm256_extracti128_si256(tail, 1);
+
+                    _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + offset), lane_first);
+                    _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + offset + 16), lane_second);
+
+                    if constexpr (M == string_conversion_mode::curly_braces)
+                    {
+                        uint32_t const digits = static_cast<uint32_t>(_mm_cvtsi128_si32(lane_tail));
+                        dst[0] = '{';
+                        memcpy(dst + 33, &digits, sizeof(uint32_t));
+                        dst[37] = '}';
+                        dst[38] = separator;
+                    }
+                    else
+                    {
+                        uint64_t const digits = static_cast<uint64_t>(_mm_cvtsi128_si64(lane_tail));
+                        memcpy(dst + 32, &digits, 5);
+                    }
+                }
+            }
+        }
+
+        /**
+         * Formats the uuids two at a time, and returns how many were written. An odd uuid at the end is left over.
+         */
+        template<string_conversion_mode M>
+        UUID_LIB_TARGET("avx2") size_t format_pairs_avx2(std::span<uuid const> ids, char separator, char* out) noexcept
+        {
+            size_t constexpr stride = string_length<M> + 1;
+
+            size_t i = 0;
+            for (; i + 2 <= ids.size(); i += 2, out += 2 * stride)
+            {
+                __m256i lo_chars, hi_chars;
+                octets_to_hex_avx2(_mm256_loadu_si256(reinterpret_cast<__m256i const*>(ids[i].octets.data())), lo_chars, hi_chars);
+                store_pair_avx2<M>(lo_chars, hi_chars, out, separator);
+            }
+
+            return i;
+        }
+#endif
+    }
+
+    template<string_conversion_mode Mode>
+    std::to_chars_result format_uuids(std::span<uuid const> ids, char separator, char* first, char* last) noexcept
+    {
+        size_t constexpr stride = string_length<Mode> + 1;
+        if (last - first < static_cast<ptrdiff_t>(bulk_string_length<Mode>(ids.size())))
+        {
+            return { last, std::errc::value_too_large };
+        }
+
+        char* out = first;
+        size_t i = 0;
+
+#ifdef UUID_LIB_USE_SIMD
+        if constexpr (detail::is_hex_mode<Mode>)
+        {
+            if (detail::has_avx2())
+            {
+                i = detail::format_pairs_avx2<Mode>(ids, separator, out);
+                out += i * stride;
+            }
+        }
+#endif
+
+        for (; i < ids.size(); ++i, out += stride)
+        {
+            detail::format_octets<Mode>(ids[i].octets.data(), out, false);
+            out[stride - 1] = separator;
+        }
+
+        return { out, std::errc{} };
+    }
+
+    template<string_conversion_mode Mode>
+    std::to_chars_result format_uuids(std::span<uuid const> ids, char separator, std::span<char> out) noexcept
+    {
+        return format_uuids<Mode>(ids, separator, out.data(), out.data() + out.size());
+    }
+
+    template<string_conversion_mode Mode>
+    parse_uuids_result parse_uuids(std::string_view text, std::span<uuid> out) noexcept
+    {
+        size_t constexpr length = string_length<Mode>;
+        char const* const begin = text.data();
+        char const* const end = begin + text.size();
+
+        char const* it = begin;
+        size_t num_parsed = 0;
+
+        while (true)
+        {
+            while (it != end and detail::is_uuid_separator(*it))
+            {
+                ++it;
+            }
+
+            if (it == end)
+            {
+                return { num_parsed, text.size(), std::errc{} };
+            }
+
+            if (num_parsed == out.size())
+            {
+                return { num_parsed, static_cast<size_t>(it - begin), std::errc::value_too_large };
+            }
+
+            // An entry is well formed if it decodes and is followed by a separator or the end of the text
+            if (end - it < static_cast<ptrdiff_t>(length) or (it + length != end and not detail::is_uuid_separator(it[length])))
+            {
+                return { num_parsed, static_cast<size_t>(it - begin), std::errc::invalid_argument };
+            }
+
+            char const* hex_begin = it;
+            if constexpr (Mode == string_conversion_mode::curly_braces)
+            {
+                if (it[0] != '{' or it[length - 1] != '}')
+                {
+                    return { num_parsed, static_cast<size_t>(it - begin), std::errc::invalid_argument };
+                }
+
+                ++hex_begin;
+            }
+
+            // Decoded aside, so that a malformed entry leaves the caller's slot untouched
+            uuid id;
+            if (not detail::parse_octets<Mode>(hex_begin, id.octets.data()))
+            {
+                return { num_parsed, static_cast<size_t>(it - begin), std::errc::invalid_argument };
+            }
+
+            out[num_parsed++] = id;
+            it += length;
+        }
+    }
+
+    template<string_conversion_mode Mode>
+    parse_uuids_result parse_uuids(std::string_view text, std::vector<uuid>& out_vec)
+    {
+        // Every entry needs at least one separator, except possibly the last one
+        size_t const first_new = out_vec.size();
+        out_vec.resize(first_new + text.size() / (string_length<Mode> + 1) + 1);
+
+        parse_uuids_result const result = parse_uuids<Mode>(text, std::span<uuid>(out_vec).subspan(first_new));
+
+        out_vec.resize(first_new + result.num_parsed);
+        return result;
+    }
+}
@@ -0,0 +1,223 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <concepts>
+#include <cstdint>
+#include <thread>
+
+#if defined(__linux__)
+#include <time.h>
+#endif
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include <intrin.h>
+#define UUID_LIB_HAS_RDTSC
+#elif defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define UUID_LIB_HAS_RDTSC
+#endif
+
+namespace LambdaSnail::Uuid
+{
+    /**
+     * The requirements on a clock policy for uuid_factory. now() returns the time since the Unix epoch. It is called
+     * from one thread at a time per factory, so a policy may keep state without synchronization.
+     */
+    template<typename clock_policy_t>
+    concept uuid_clock = requires(clock_policy_t& clock)
+    {
+        { clock.now() } -> std::same_as<std::chrono::nanoseconds>;
+    };
+
+    /**
+     * A clock policy that can be read from several threads at once, as needed by v7_sequencer.
+     */
+    template<typename clock_policy_t>
+    concept shared_uuid_clock = uuid_clock<clock_policy_t> and requires(clock_policy_t const& clock)
+    {
+        { clock.now() } -> std::same_as<std::chrono::nanoseconds>;
+    };
+
+    namespace detail
+    {
+        /**
+         * The number of bits of a v7 tick below the millisecond, which fill rand_a (method 3 in section 6.2 of the RFC).
+         */
+        inline constexpr uint64_t s_v7_sub_ms_bits = 12;
+
+        /**
+         * Converts a time since the Unix epoch to a v7 tick: the milliseconds in the upper bits and the scaled fraction
+         * of the millisecond in the lower 12 bits, so that incrementing a tick carries from the fraction into the
+         * millisecond. One step is 1/4096 ms, about 244 ns.
+         */
+        inline uint64_t to_v7_tick(std::chrono::nanoseconds time) noexcept
+        {
+            uint64_t constexpr ns_per_ms = 1'000'000;
+            uint64_t const ns = static_cast<uint64_t>(time.count());
+            return (ns / ns_per_ms) << s_v7_sub_ms_bits | ((ns % ns_per_ms) << s_v7_sub_ms_bits) / ns_per_ms;
+        }
+    }
+
+    /**
+     * Reads std::chrono::system_clock on every call. This is the default, and the most accurate.
+     */
+    struct system_clock_policy
+    {
+        [[nodiscard]] std::chrono::nanoseconds now() const noexcept
+        {
+            return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::system_clock::now().time_since_epoch());
+        }
+    };
+
+    /**
+     * Reads CLOCK_REALTIME_COARSE on Linux, which is served from the vDSO without reading the hardware clock. Its
+     * resolution is one kernel tick (typically 1 to 4 ms), so several calls in a row often return the same time. This
+     * is fine for the millisecond timestamp of v7, and create_uuid_v7_monotonic keeps its uuids ordered, but the sub-
+     * millisecond fraction carries no information.
+     *
+     * On other platforms this falls back to system_clock.
+     */
+    struct coarse_clock_policy
+    {
+        [[nodiscard]] std::chrono::nanoseconds now() const noexcept
+        {
+#if defined(__linux__) && defined(CLOCK_REALTIME_COARSE)
+            timespec ts;
+            clock_gettime(CLOCK_REALTIME_COARSE, &ts);
+            return std::chrono::seconds(ts.tv_sec) + std::chrono::nanoseconds(ts.tv_nsec);
+#else
+            return system_clock_policy().now();
+#endif
+        }
+    };
+
+    /**
+     * Derives the time from the cpu timestamp counter, which takes a few nanoseconds to read. The counter is converted
+     * to wall clock time with an anchor (a pair of system_clock time and counter value) and a rate.
+     *
+     * The policy calibrates itself while it is used: the first calls read system_clock, and once some time has passed
+     * the rate is measured over the whole time since the first call. After that, the anchor is renewed from
+     * system_clock about every 100 ms, which keeps the time within a small error of system_clock and follows
+     * adjustments of the system time.
+     *
+     * This needs a constant rate timestamp counter, which all x86 cpus of the last decade have. On other architectures
+     * steady_clock is used in place of the counter.
+     */
+    class tsc_clock_policy
+    {
+    public:
+        [[nodiscard]] std::chrono::nanoseconds now() noexcept
+        {
+            uint64_t const ticks = read_ticks();
+            uint64_t const elapsed = ticks - m_anchor_ticks;
+            if (elapsed >= m_resync_ticks) [[unlikely]]
+            {
+                return resync(ticks);
+            }
+
+            return m_anchor_time + std::chrono::nanoseconds(static_cast<int64_t>(static_cast<double>(elapsed) * m_ns_per_tick));
+        }
+
+    private:
+        static inline constexpr std::chrono::nanoseconds s_resync_interval = std::chrono::milliseconds(100);
+
+        /**
+         * The rate is not used before it has been measured over at least this long.
+         */
+        static inline constexpr std::chrono::nanoseconds s_min_calibration = std::chrono::milliseconds(10);
+
+        std::chrono::nanoseconds m_anchor_time{};
+        uint64_t m_anchor_ticks = 0;
+        uint64_t m_resync_ticks = 0;
+        double m_ns_per_tick = 0.0;
+
+        std::chrono::nanoseconds m_first_time{};
+        uint64_t m_first_ticks = 0;
+
+        static uint64_t read_ticks() noexcept
+        {
+#ifdef UUID_LIB_HAS_RDTSC
+            return __rdtsc();
+#else
+            return static_cast<uint64_t>(std::chrono::steady_clock::now().time_since_epoch().count());
+#endif
+        }
+
+        std::chrono::nanoseconds resync(uint64_t ticks) noexcept
+        {
+            std::chrono::nanoseconds const time = system_clock_policy().now();
+            if (m_first_ticks == 0)
+            {
+                m_first_time = time;
+                m_first_ticks = ticks;
+            }
+            else if (time - m_first_time >= s_min_calibration and ticks > m_first_ticks)
+            {
+                m_ns_per_tick = static_cast<double>((time - m_first_time).count()) / static_cast<double>(ticks - m_first_ticks);
+                m_resync_ticks = static_cast<uint64_t>(static_cast<double>(s_resync_interval.count()) / m_ns_per_tick);
+            }
+
+            m_anchor_time = time;
+            m_anchor_ticks = ticks;
+            return time;
+        }
+    };
+
+    namespace detail
+    {
+        /**
+         * Keeps the current time in an atomic, updated by a background thread once per millisecond. The thread is
+         * started on first use and stopped when the program exits.
+         */
+        class clock_ticker
+        {
+        public:
+            clock_ticker() :
+                m_time(system_clock_policy().now().count()),
+                m_thread([this](std::stop_token const& stop)
+                {
+                    while (not stop.stop_requested())
+                    {
+                        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+                        m_time.store(system_clock_policy().now().count(), std::memory_order_relaxed);
+                    }
+                })
+            {}
+
+            [[nodiscard]] std::chrono::nanoseconds now() const noexcept
+            {
+                return std::chrono::nanoseconds(m_time.load(std::memory_order_relaxed));
+            }
+
+            static clock_ticker& instance()
+            {
+                static clock_ticker ticker;
+                return ticker;
+            }
+
+        private:
+            // On its own cache line, since every thread creating uuids reads it
+            alignas(64) std::atomic<int64_t> m_time;
+            std::jthread m_thread;
+        };
+    }
+
+    /**
+     * Reads the time from an atomic that a shared background thread updates every millisecond, so a call is a single
+     * load. The time lags behind system_clock by up to about a millisecond (more if the thread is not scheduled in
+     * time), and the sub-millisecond fraction is not meaningful.
+     */
+    struct cached_clock_policy
+    {
+        cached_clock_policy() : m_ticker(&detail::clock_ticker::instance()) {}
+
+        [[nodiscard]] std::chrono::nanoseconds now() const noexcept
+        {
+            return m_ticker->now();
+        }
+
+    private:
+        detail::clock_ticker const* m_ticker;
+    };
+}
@@ -0,0 +1,441 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include "uuid.hpp"
+
+namespace LambdaSnail::Uuid
+{
+    namespace detail
+    {
+        inline constexpr size_t s_column_block_size = 128;
+
+        /**
+         * The index entry of one compressed block of a uuid_column. The upper and lower halves of each uuid (octets
+         * 0-7 and 8-15, read big endian) are stored as their difference to the smallest half in the block, packed with
+         * just enough bits for the largest difference. The packed upper halves take 2 * hi_width words starting at
+         * word_offset, and the lower halves 2 * lo_width words after them.
+         */
+        struct column_block
+        {
+            uint64_t hi_base;
+            uint64_t lo_base;
+            uint64_t word_offset;
+            uint8_t hi_width;
+            uint8_t lo_width;
+        };
+
+        inline uint64_t bit_width_mask(uint32_t width) noexcept
+        {
+            return width == 64 ? ~static_cast<uint64_t>(0) : (static_cast<uint64_t>(1) << width) - 1;
+        }
+
+        /**
+         * Packs the values of a block with width bits each, value i at bit i * width of the words, which must be
+         * zeroed.
+         */
+        inline void pack_bits(uint64_t const* values, uint32_t width, uint64_t* words) noexcept
+        {
+            if (width == 0)
+            {
+                return;
+            }
+
+            for (size_t i = 0; i < s_column_block_size; ++i)
+            {
+                uint64_t const offset = i * width;
+                uint64_t const shift = offset & 63;
+                words[offset >> 6] |= values[i] << shift;
+                if (shift + width > 64)
+                {
+                    words[(offset >> 6) + 1] |= values[i] >> (64 - shift);
+                }
+            }
+        }
+
+        inline uint64_t unpack_bits(uint64_t const* words, uint32_t width, size_t index) noexcept
+        {
+            if (width == 0)
+            {
+                return 0;
+            }
+
+            uint64_t const offset = index * width;
+            uint64_t const shift = offset & 63;
+            uint64_t value = words[offset >> 6] >> shift;
+            if (shift + width > 64)
+            {
+                value |= words[(offset >> 6) + 1] << (64 - shift);
+            }
+
+            return value & bit_width_mask(width);
+        }
+
+        /**
+         * Writes the uuids at positions first to first + count - 1 of a block to out, 16 octets each.
+         */
+        inline void decode_column_block_baseline(column_block const& block, uint64_t const* words, size_t first, size_t count, uint8_t* out) noexcept
+        {
+            uint64_t const* hi_words = words + block.word_offset;
+            uint64_t const* lo_words = hi_words + 2 * static_cast<size_t>(block.hi_width);
+
+            for (size_t i = first; i < first + count; ++i, out += sizeof(uuid::octet_set_t))
+            {
+                store_big_endian(out, block.hi_base + unpack_bits(hi_words, block.hi_width, i));
+                store_big_endian(out + 8, block.lo_base + unpack_bits(lo_words, block.lo_width, i));
+            }
+        }
+
+#ifdef UUID_LIB_USE_SIMD
+        /**
+         * Unpacks eight consecutive values, starting at value first. The words they are in (at most nine) are loaded
+         * with two masked loads, so nothing past the end of the block is read, and picked out for each lane with a
+         * two-register permute.
+         */
+        UUID_LIB_TARGET("avx512f") inline __m512i unpack_bits_avx512(uint64_t const* words, uint32_t width, size_t first) noexcept
+        {
+            if (width == 0)
+            {
+                return _mm512_setzero_si512();
+            }
+
+            uint64_t const first_bit = first * width;
+            size_t const first_word = first_bit >> 6;
+            size_t const available = 2 * static_cast<size_t>(width) - first_word;
+
+            __m512i const offsets = _mm512_add_epi64(
+                _mm512_set1_epi64(static_cast<int64_t>(first_bit & 63)),
+                _mm512_mul_epu32(_mm512_setr_epi64(0, 1, 2, 3, 4, 5, 6, 7), _mm512_set1_epi64(width)));
+            __m512i const index = _mm512_srli_epi64(offsets, 6);
+            __m512i const shift = _mm512_and_si512(offsets, _mm512_set1_epi64(63));
+
+            auto const first_mask = static_cast<__mmask8>(available >= 8 ? 0xFF : (1u << available) - 1);
+            auto const second_mask = static_cast<__mmask8>(available >= 16 ? 0xFF : available > 8 ? (1u << (available - 8)) - 1 : 0);
+            __m512i const a = _mm512_maskz_loadu_epi64(first_mask, words + first_word);
+            __m512i const b = _mm512_maskz_loadu_epi64(second_mask, words + first_word + 8);
+
+            __m512i const low = _mm512_permutex2var_epi64(a, index, b);
+            __m512i const high = _mm512_permutex2var_epi64(a, _mm512_add_epi64(index, _mm512_set1_epi64(1)), b);
+
+            // A shift by 64 gives zero, for values that do not reach into the next word
+            __m512i const value = _mm512_or_si512(_mm512_srlv_epi64(low, shift), _mm512_sllv_epi64(high, _mm512_sub_epi64(_mm512_set1_epi64(64), shift)));
+            return _mm512_and_si512(value, _mm512_set1_epi64(static_cast<int64_t>(bit_width_mask(width))));
+        }
+
+        /**
+         * Reverses the bytes of each 64-bit lane with AVX-512F alone: the bytes of each 16-bit word, then the words of
+         * each 32-bit half, then the halves.
+         */
+        UUID_LIB_TARGET("avx512f") inline __m512i byte_swap_64_avx512(__m512i v) noexcept
+        {
+            __m512i const odd_bytes = _mm512_set1_epi32(0x00FF00FF);
+            __m512i const swapped = _mm512_or_si512(
+                _mm512_and_si512(_mm512_srli_epi32(v, 8), odd_bytes),
+                _mm512_andnot_si512(odd_bytes, _mm512_slli_epi32(v, 8)));
+
+            return _mm512_rol_epi64(_mm512_rol_epi32(swapped, 16), 32);
+        }
+
+        UUID_LIB_TARGET("avx512f") inline void decode_column_block_avx512(column_block const& block, uint64_t const* words, size_t first, size_t count, uint8_t* out) noexcept
+        {
+            uint64_t const* hi_words = words + block.word_offset;
+            uint64_t const* lo_words = hi_words + 2 * static_cast<size_t>(block.hi_width);
+
+            __m512i const hi_base = _mm512_set1_epi64(static_cast<int64_t>(block.hi_base));
+            __m512i const lo_base = _mm512_set1_epi64(static_cast<int64_t>(block.lo_base));
+
+            size_t i = first;
+            for (; i + 8 <= first + count; i += 8, out += 8 * sizeof(uuid::octet_set_t))
+            {
+                __m512i const hi = byte_swap_64_avx512(_mm512_add_epi64(hi_base, unpack_bits_avx512(hi_words, block.hi_width, i)));
+                __m512i const lo = byte_swap_64_avx512(_mm512_add_epi64(lo_base, unpack_bits_avx512(lo_words, block.lo_width, i)));
+
+                // Interleave the halves into four uuids per register
+                _mm512_storeu_si512(out, _mm512_permutex2var_epi64(hi, _mm512_setr_epi64(0, 8, 1, 9, 2, 10, 3, 11), lo));
+                _mm512_storeu_si512(out + 64, _mm512_permutex2var_epi64(hi, _mm512_setr_epi64(4, 12, 5, 13, 6, 14, 7, 15), lo));
+            }
+
+            decode_column_block_baseline(block, words, i, first + count - i, out);
+        }
+
+        /**
+         * Unpacks four consecutive values, starting at value first. They start in the first four of the words they
+         * are in, so each lane picks its low word from those and its high word from the four after the first, with a
+         * permute instead of a gather. The masked loads keep the reads inside the block.
+         */
+        UUID_LIB_TARGET("avx2") inline __m256i unpack_bits_avx2(uint64_t const* words, uint32_t width, size_t first) noexcept
+        {
+            if (width == 0)
+            {
+                return _mm256_setzero_si256();
+            }
+
+            uint64_t const first_bit = first * width;
+            size_t const first_word = first_bit >> 6;
+            size_t const available = 2 * static_cast<size_t>(width) - first_word;
+
+            __m256i const offsets = _mm256_add_epi64(
+                _mm256_set1_epi64x(static_cast<int64_t>(first_bit & 63)),
+                _mm256_mul_epu32(_mm256_setr_epi64x(0, 1, 2, 3), _mm256_set1_epi64x(width)));
+            __m256i const index = _mm256_srli_epi64(offsets, 6);
+            __m256i const shift = _mm256_and_si256(offsets, _mm256_set1_epi64x(63));
+
+            // Word i of a lane is the pair of 32-bit elements 2i and 2i + 1
+            __m256i const even_index = _mm256_slli_epi64(index, 1);
+            __m256i const pair_index = _mm256_add_epi64(_mm256_or_si256(even_index, _mm256_slli_epi64(even_index, 32)), _mm256_set1_epi64x(0x0000000100000000));
+
+            __m256i const lane = _mm256_setr_epi64x(0, 1, 2, 3);
+            auto const* base = reinterpret_cast<long long const*>(words + first_word);
+            __m256i const low_words = _mm256_maskload_epi64(base, _mm256_cmpgt_epi64(_mm256_set1_epi64x(static_cast<int64_t>(available)), lane));
+            __m256i const high_words = _mm256_maskload_epi64(base + 1, _mm256_cmpgt_epi64(_mm256_set1_epi64x(static_cast<int64_t>(available) - 1), lane));
+
+            __m256i const low = _mm256_permutevar8x32_epi32(low_words, pair_index);
+            __m256i const high = _mm256_permutevar8x32_epi32(high_words, pair_index);
+
+            __m256i const value = _mm256_or_si256(_mm256_srlv_epi64(low, shift), _mm256_sllv_epi64(high, _mm256_sub_epi64(_mm256_set1_epi64x(64), shift)));
+            return _mm256_and_si256(value, _mm256_set1_epi64x(static_cast<int64_t>(bit_width_mask(width))));
+        }
+
+        UUID_LIB_TARGET("avx2") inline void decode_column_block_avx2(column_block const& block, uint64_t const* words, size_t first, size_t count, uint8_t* out) noexcept
+        {
+            uint64_t const* hi_words = words + block.word_offset;
+            uint64_t const* lo_words = hi_words + 2 * static_cast<size_t>(block.hi_width);
+
+            __m256i const hi_base = _mm256_set1_epi64x(static_cast<int64_t>(block.hi_base));
+            __m256i const lo_base = _mm256_set1_epi64x(static_cast<int64_t>(block.lo_base));
+            __m256i const byte_swap = _mm256_broadcastsi128_si256(_mm_setr_epi8(7, 6, 5, 4, 3, 2, 1, 0, 15, 14, 13, 12, 11, 10, 9, 8));
+
+            size_t i = first;
+            for (; i + 4 <= first + count; i += 4, out += 4 * sizeof(uuid::octet_set_t))
+            {
+                __m256i const hi = _mm256_shuffle_epi8(_mm256_add_epi64(hi_base, unpack_bits_avx2(hi_words, block.hi_width, i)), byte_swap);
+                __m256i const lo = _mm256_shuffle_epi8(_mm256_add_epi64(lo_base, unpack_bits_avx2(lo_words, block.lo_width, i)), byte_swap);
+
+                // Uuids 0 and 2 in one register, 1 and 3 in the other
+                __m256i const even = _mm256_unpacklo_epi64(hi, lo);
+                __m256i const odd = _mm256_unpackhi_epi64(hi, lo);
+                _mm256_storeu_si256(reinterpret_cast<__m256i*>(out), _mm256_permute2x128_si256(even, odd, 0x20));
+                _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + 32), _mm256_permute2x128_si256(even, odd, 0x31));
+            }
+
+            decode_column_block_baseline(block, words, i, first + count - i, out);
+        }
+#endif
+
+        inline void decode_column_block(column_block const& block, uint64_t const* words, size_t first, size_t count, uint8_t* out) noexcept
+        {
+#ifdef UUID_LIB_USE_SIMD
+            if (has_avx512f())
+            {
+                decode_column_block_avx512(block, words, first, count, out);
+                return;
+            }
+
+            if (has_avx2())
+            {
+                decode_column_block_avx2(block, words, first, count, out);
+                return;
+            }
+#endif
+            decode_column_block_baseline(block, words, first, count, out);
+        }
+    }
+
+    /**
+     * A compressed, append-only column of uuids, meant for holding large numbers of v7 uuids in memory for scans.
+     * The uuids are stored in blocks of 128. In each block, the upper half (timestamp, version and rand_a) and the
+     * lower half (variant and rand_b) of every uuid are stored as the difference to the smallest half in the block,
+     * bit-packed with just as many bits as the largest difference needs.
+     *
+     * This suits the batch functions of uuid_factory well. A batch from create_uuids_monotonic_random has one upper
+     * half and a counter in the lower half, so a block takes a few bits per uuid. A batch from
+     * create_uuids_dedicated_counter or create_uuids_rolling_counter has a counter in the upper half, but its rand_b
+     * is random, which cannot be compressed: such uuids take a little over eight octets each. Random uuids (v4) take
+     * as much space as in a std::vector<uuid>.
+     *
+     * Every block has an index entry, so the uuid at any position is found without decoding the blocks before it.
+     * Blocks are decoded eight (AVX-512) or four (AVX2) uuids at a time. The last, partial block is kept uncompressed
+     * until it is full.
+     */
+    class uuid_column
+    {
+    public:
+        /**
+         * The number of uuids per compressed block.
+         */
+        static inline constexpr size_t s_block_size = detail::s_column_block_size;
+
+        uuid_column() = default;
+
+        /**
+         * Appends a uuid. Every s_block_size uuids, the uncompressed tail is compressed into a block.
+         */
+        void push_back(uuid const& id)
+        {
+            m_tail.push_back(id);
+            if (m_tail.size() == s_block_size)
+            {
+                compress_block(m_tail.data());
+                m_tail.clear();
+            }
+        }
+
+        /**
+         * Appends a sequence of uuids. Whole blocks are compressed straight from the input.
+         */
+        void append(std::span<uuid const> ids)
+        {
+            while (not ids.empty() and not m_tail.empty())
+            {
+                push_back(ids.front());
+                ids = ids.subspan(1);
+            }
+
+            for (; ids.size() >= s_block_size; ids = ids.subspan(s_block_size))
+            {
+                compress_block(ids.data());
+            }
+
+            m_tail.insert(m_tail.end(), ids.begin(), ids.end());
+        }
+
+        [[nodiscard]] size_t size() const noexcept { return m_blocks.size() * s_block_size + m_tail.size(); }
+        [[nodiscard]] bool empty() const noexcept { return size() == 0; }
+
+        /**
+         * Returns the uuid at a position, which must be less than size(). Only the two packed halves of that uuid are
+         * read.
+         */
+        [[nodiscard]] uuid operator[](size_t index) const noexcept
+        {
+            size_t const block = index / s_block_size;
+            if (block == m_blocks.size())
+            {
+                return m_tail[index % s_block_size];
+            }
+
+            uuid id;
+            detail::decode_column_block_baseline(m_blocks[block], m_words.data(), index % s_block_size, 1, id.octets.data());
+            return id;
+        }
+
+        /**
+         * Decodes consecutive uuids into the span.
+         * @param first The position of the first uuid to decode.
+         * @param out_ids The output uuids. first + out_ids.size() must not be greater than size().
+         */
+        void decode(size_t first, std::span<uuid> out_ids) const noexcept
+        {
+            size_t done = 0;
+            while (done < out_ids.size())
+            {
+                size_t const position = first + done;
+                size_t const block = position / s_block_size;
+                size_t const offset = position % s_block_size;
+                size_t const count = std::min(s_block_size - offset, out_ids.size() - done);
+
+                if (block == m_blocks.size())
+                {
+                    std::copy_n(m_tail.begin() + static_cast<ptrdiff_t>(offset), count, out_ids.begin() + static_cast<ptrdiff_t>(done));
+                }
+                else
+                {
+                    detail::decode_column_block(m_blocks[block], m_words.data(), offset, count, out_ids[done].octets.data());
+                }
+
+                done += count;
+            }
+        }
+
+        /**
+         * Decodes the column a block at a time into a buffer and calls func with a std::span<uuid const> of each
+         * block (and of the tail), in order. This is the fastest way to scan the whole column.
+         */
+        template<typename func_t>
+        void for_each_block(func_t&& func) const
+        {
+            std::array<uuid, s_block_size> buffer;
+            for (detail::column_block const& block : m_blocks)
+            {
+                detail::decode_column_block(block, m_words.data(), 0, s_block_size, buffer.data()->octets.data());
+                func(std::span<uuid const>(buffer));
+            }
+
+            if (not m_tail.empty())
+            {
+                func(std::span<uuid const>(m_tail));
+            }
+        }
+
+        /**
+         * Returns the number of bytes allocated by the column, for comparison with size() * sizeof(uuid).
+         */
+        [[nodiscard]] size_t memory_usage() const noexcept
+        {
+            return m_blocks.capacity() * sizeof(detail::column_block) + m_words.capacity() * sizeof(uint64_t) + m_tail.capacity() * sizeof(uuid);
+        }
+
+        void clear() noexcept
+        {
+            m_blocks.clear();
+            m_words.clear();
+            m_tail.clear();
+        }
+
+        /**
+         * Frees the memory that was allocated ahead for growth.
+         */
+        void shrink_to_fit()
+        {
+            m_blocks.shrink_to_fit();
+            m_words.shrink_to_fit();
+            m_tail.shrink_to_fit();
+        }
+
+    private:
+        std::vector<detail::column_block> m_blocks;
+        std::vector<uint64_t> m_words;
+        std::vector<uuid> m_tail;
+
+        static_assert(sizeof(uuid) == sizeof(uuid::octet_set_t), "The decoders write uuids as contiguous octets");
+
+        void compress_block(uuid const* ids)
+        {
+            std::array<uint64_t, s_block_size> hi, lo;
+            for (size_t i = 0; i < s_block_size; ++i)
+            {
+                hi[i] = detail::load_big_endian(ids[i].octets.data());
+                lo[i] = detail::load_big_endian(ids[i].octets.data() + 8);
+            }
+
+            auto const [hi_min, hi_max] = std::minmax_element(hi.begin(), hi.end());
+            auto const [lo_min, lo_max] = std::minmax_element(lo.begin(), lo.end());
+
+            detail::column_block block;
+            block.hi_base = *hi_min;
+            block.lo_base = *lo_min;
+            block.word_offset = m_words.size();
+            block.hi_width = static_cast<uint8_t>(std::bit_width(*hi_max - *hi_min));
+            block.lo_width = static_cast<uint8_t>(std::bit_width(*lo_max - *lo_min));
+
+            for (size_t i = 0; i < s_block_size; ++i)
+            {
+                hi[i] -= block.hi_base;
+                lo[i] -= block.lo_base;
+            }
+
+            // 128 values of width bits take 2 * width words
+            m_words.resize(m_words.size() + 2 * (static_cast<size_t>(block.hi_width) + block.lo_width), 0);
+            uint64_t* words = m_words.data() + block.word_offset;
+            detail::pack_bits(hi.data(), block.hi_width, words);
+            detail::pack_bits(lo.data(), block.lo_width, words + 2 * static_cast<size_t>(block.hi_width));
+
+            m_blocks.push_back(block);
+        }
+    };
+}
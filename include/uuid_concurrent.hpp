@@ -0,0 +1,207 @@
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <concepts>
+#include <cstdint>
+#include <mutex>
+#include <random>
+#include <span>
+#include <vector>
+
+#include "uuid.hpp"
+#include "uuid_factory.hpp"
+#include "xoroshiro128.hpp"
+
+namespace LambdaSnail::Uuid
+{
+    /**
+     * The requirements on a random number generator that can be split into non-overlapping streams, like
+     * xoroshiro128pp.
+     */
+    template<typename rng_t>
+    concept jumpable_generator = requires(rng_t& rng)
+    {
+        { rng() } -> std::convertible_to<uint64_t>;
+        { rng.get_state() } -> std::convertible_to<std::array<uint64_t, 2>>;
+        rng.seed_state({ uint64_t{}, uint64_t{} });
+        rng.jump();
+    };
+
+    /**
+     * Creates uuids from any number of threads without locks. Each thread gets its own uuid_factory in thread_local
+     * storage, the first time it creates a uuid. The generator of that factory is a copy of a process-wide generator,
+     * seeded randomly, which is then advanced with jump(). So the n-th thread starts from the seed advanced by n jumps,
+     * and every thread draws from its own non-overlapping stream of 2^64 random numbers. A uuid_factory per thread
+     * seeded from the clock, on the other hand, risks threads starting from the same or correlated states.
+     *
+     * After the first call on a thread, creating a uuid costs the same as with a uuid_factory. The first call takes a
+     * lock and costs one jump(), however many threads came before.
+     *
+     * The factory itself holds no state: all instances for the same generator type share the per-thread factories.
+     *
+     * @tparam rng_t The type of the random number generator, see jumpable_generator.
+     * @tparam clock_policy_t Where v7 timestamps are read from, see uuid_clock.hpp.
+     */
+    template<jumpable_generator rng_t = xoroshiro128pp, uuid_clock clock_policy_t = system_clock_policy>
+    struct concurrent_uuid_factory
+    {
+        /**
+         * Creates a single version four uuid with the generator of the calling thread.
+         * @param out_id The output uuid.
+         */
+        void create_uuid_v4(uuid& out_id) noexcept { local().create_uuid_v4(out_id); }
+
+        /**
+         * Fills the span with version four uuids, see uuid_factory::create_uuids_v4.
+         */
+        void create_uuids_v4(std::span<uuid> out_ids) noexcept { local().create_uuids_v4(out_ids); }
+
+        /**
+         * Creates a single version seven uuid with the generator of the calling thread.
+         * @param out_id The output uuid.
+         */
+        void create_uuid_v7(uuid& out_id) noexcept { local().create_uuid_v7(out_id); }
+
+        /**
+         * Creates a version seven uuid that is strictly greater than the previous one created on the calling thread,
+         * see uuid_factory::create_uuid_v7_monotonic. uuids from different threads are not ordered.
+         * @param out_id The output uuid.
+         */
+        void create_uuid_v7_monotonic(uuid& out_id) noexcept { local().create_uuid_v7_monotonic(out_id); }
+
+        /**
+         * Creates a version seven uuid from the next slot of a shared sequencer, see uuid_factory::create_uuid_v7.
+         */
+        template<shared_uuid_clock sequencer_clock_t>
+        void create_uuid_v7(v7_sequencer<sequencer_clock_t>& sequencer, uuid& out_id) noexcept
+        {
+            local().create_uuid_v7(sequencer, out_id);
+        }
+
+        /**
+         * Fills the span with consecutive version seven uuids from a shared sequencer, see uuid_factory::create_uuids_v7.
+         */
+        template<shared_uuid_clock sequencer_clock_t>
+        void create_uuids_v7(v7_sequencer<sequencer_clock_t>& sequencer, std::span<uuid> out_ids) noexcept
+        {
+            local().create_uuids_v7(sequencer, out_ids);
+        }
+
+        /**
+         * Creates a batch of uuids with a dedicated counter, see uuid_factory::create_uuids_dedicated_counter.
+         */
+        void create_uuids_dedicated_counter(uint16_t num_uuids, std::vector<uuid>& out_vec) noexcept
+        {
+            local().create_uuids_dedicated_counter(num_uuids, out_vec);
+        }
+
+        /**
+         * Creates a batch of uuids with a rolling dedicated counter, see uuid_factory::create_uuids_rolling_counter.
+         * uuids from different threads are not ordered.
+         */
+        void create_uuids_rolling_counter(uint32_t num_uuids, std::vector<uuid>& out_vec,
+            std::chrono::milliseconds max_skew = uuid_factory<rng_t, clock_policy_t>::s_default_max_skew) noexcept
+        {
+            local().create_uuids_rolling_counter(num_uuids, out_vec, max_skew);
+        }
+
+        /**
+         * Creates a batch of uuids with a monotonic random counter, see uuid_factory::create_uuids_monotonic_random.
+         */
+        void create_uuids_monotonic_random(uint32_t num_uuids, uint32_t increment, std::vector<uuid>& out_vec) noexcept
+        {
+            local().create_uuids_monotonic_random(num_uuids, increment, out_vec);
+        }
+
+        /**
+         * Returns the factory of the calling thread. It must not be shared with other threads.
+         */
+        [[nodiscard]] static uuid_factory<rng_t, clock_policy_t>& local() noexcept;
+
+    private:
+        struct thread_state
+        {
+            thread_state() noexcept;
+
+            uuid_factory<rng_t, clock_policy_t> factory;
+        };
+    };
+
+    namespace detail
+    {
+        /**
+         * Expands a 64-bit value into well mixed generator state, as suggested by the authors of xoroshiro.
+         */
+        inline uint64_t splitmix64(uint64_t& x) noexcept
+        {
+            uint64_t z = (x += 0x9E3779B97F4A7C15ull);
+            z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+            z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+            return z ^ (z >> 31);
+        }
+
+        /**
+         * The state all thread streams are jumped from. This is drawn once per process, from the system entropy
+         * source mixed with the clock in case the entropy source is deterministic.
+         */
+        inline std::array<uint64_t, 2> const& root_stream_state()
+        {
+            static std::array<uint64_t, 2> const state = []
+            {
+                std::random_device device;
+                uint64_t seed = (static_cast<uint64_t>(device()) << 32 | device())
+                    ^ static_cast<uint64_t>(std::chrono::steady_clock::now().time_since_epoch().count());
+
+                std::array<uint64_t, 2> result = { splitmix64(seed), splitmix64(seed) };
+                if ((result[0] | result[1]) == 0)
+                {
+                    result[1] = 1; // The all-zero state would only ever produce zeros
+                }
+
+                return result;
+            }();
+
+            return state;
+        }
+
+        /**
+         * Returns the state of the next thread stream. A process-wide generator per generator type, seeded with the
+         * root state, hands out its state and is then jumped past it. Factories with different clocks share it, so
+         * that they do not draw from the same stream.
+         */
+        template<jumpable_generator rng_t>
+        std::array<uint64_t, 2> take_thread_stream()
+        {
+            static std::mutex mutex;
+            static rng_t next;
+            static bool seeded = false;
+
+            std::lock_guard const lock(mutex);
+            if (not seeded)
+            {
+                std::array<uint64_t, 2> const& root = root_stream_state();
+                next.seed_state({ root[0], root[1] });
+                seeded = true;
+            }
+
+            std::array<uint64_t, 2> const stream = next.get_state();
+            next.jump();
+            return stream;
+        }
+    }
+
+    template<jumpable_generator rng_t, uuid_clock clock_policy_t>
+    concurrent_uuid_factory<rng_t, clock_policy_t>::thread_state::thread_state() noexcept
+    {
+        std::array<uint64_t, 2> const stream = detail::take_thread_stream<rng_t>();
+        factory.get_generator().seed_state({ stream[0], stream[1] });
+    }
+
+    template<jumpable_generator rng_t, uuid_clock clock_policy_t>
+    uuid_factory<rng_t, clock_policy_t>& concurrent_uuid_factory<rng_t, clock_policy_t>::local() noexcept
+    {
+        thread_local thread_state t_state;
+        return t_state.factory;
+    }
+}
@@ -0,0 +1,136 @@
+#pragma once
+
+#ifdef UUID_LIB_USE_SIMD
+#include <immintrin.h>
+#ifdef _MSC_VER
+#include <intrin.h>
+#else
+#include <cpuid.h>
+#endif
+#endif
+
+/**
+ * Kernels that need more than SSE2 (which every x86-64 cpu has) are compiled for their instruction set with a
+ * function attribute instead of a project-wide -march flag, and are only called after the cpu has been checked for
+ * support at runtime. This way one binary runs on old hosts and still uses AVX2/AVX-512 on new ones.
+ *
+ * MSVC allows intrinsics in any function, so there the attributes are empty.
+ */
+#if defined(__GNUC__) || defined(__clang__)
+#define UUID_LIB_TARGET(isa) __attribute__((target(isa)))
+#define UUID_LIB_ALWAYS_INLINE inline __attribute__((always_inline))
+#else
+#define UUID_LIB_TARGET(isa)
+#define UUID_LIB_ALWAYS_INLINE __forceinline
+#endif
+
+namespace LambdaSnail::Uuid
+{
+    /**
+     * The instruction set extensions used by the library, as reported by the cpu it runs on.
+     */
+    struct cpu_features
+    {
+        bool ssse3 = false;
+        bool avx2 = false;
+        bool avx512f = false;
+        bool sha = false;
+    };
+
+    /**
+     * Returns the instruction set extensions supported by the cpu. These are detected once when the program starts.
+     * Without UUID_LIB_USE_SIMD, all features are reported as unsupported.
+     */
+    [[nodiscard]] cpu_features const& get_cpu_features() noexcept;
+
+    namespace detail
+    {
+        inline cpu_features detect_cpu_features() noexcept
+        {
+            cpu_features features;
+#if defined(UUID_LIB_USE_SIMD) && defined(_MSC_VER)
+            int info[4];
+            __cpuid(info, 0);
+            int const max_leaf = info[0];
+
+            __cpuid(info, 1);
+            features.ssse3 = (info[2] & (1 << 9)) != 0;
+
+            // AVX state must also be enabled by the operating system, which is reported through xgetbv
+            bool const os_avx = (info[2] & (1 << 27)) != 0 and (_xgetbv(0) & 0x06) == 0x06;
+            bool const os_avx512 = os_avx and (_xgetbv(0) & 0xE6) == 0xE6;
+
+            if (max_leaf >= 7)
+            {
+                __cpuidex(info, 7, 0);
+                features.avx2 = os_avx and (info[1] & (1 << 5)) != 0;
+                features.avx512f = os_avx512 and (info[1] & (1 << 16)) != 0;
+                features.sha = (info[1] & (1 << 29)) != 0;
+            }
+#elif defined(UUID_LIB_USE_SIMD)
+            // The builtins also check that the operating system saves the extended registers
+            __builtin_cpu_init();
+            features.ssse3 = __builtin_cpu_supports("ssse3");
+            features.avx2 = __builtin_cpu_supports("avx2");
+            features.avx512f = __builtin_cpu_supports("avx512f");
+
+            // Not all compiler versions know the SHA extensions, so they are read from cpuid directly
+            unsigned int eax, ebx, ecx, edx;
+            if (__get_cpuid_count(7, 0, &eax, &ebx, &ecx, &edx))
+            {
+                features.sha = (ebx & (1u << 29)) != 0;
+            }
+#endif
+            return features;
+        }
+
+        /**
+         * Initialized during static initialization. Code that runs before that sees all features as unsupported and
+         * takes the portable paths, which give the same results.
+         */
+        inline cpu_features const s_cpu_features = detect_cpu_features();
+
+        // When the whole program is compiled for an instruction set anyway, the runtime check is left out
+
+        inline bool has_ssse3() noexcept
+        {
+#ifdef __SSSE3__
+            return true;
+#else
+            return s_cpu_features.ssse3;
+#endif
+        }
+
+        inline bool has_avx2() noexcept
+        {
+#ifdef __AVX2__
+            return true;
+#else
+            return s_cpu_features.avx2;
+#endif
+        }
+
+        inline bool has_avx512f() noexcept
+        {
+#ifdef __AVX512F__
+            return true;
+#else
+            return s_cpu_features.avx512f;
+#endif
+        }
+
+        inline bool has_sha() noexcept
+        {
+#if defined(__SHA__) && defined(__SSE4_1__)
+            return true;
+#else
+            return s_cpu_features.sha;
+#endif
+        }
+    }
+
+    inline cpu_features const& get_cpu_features() noexcept
+    {
+        return detail::s_cpu_features;
+    }
+}
@@ -0,0 +1,502 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <string_view>
+
+#include "uuid_cpu.hpp"
+
+namespace LambdaSnail::Uuid
+{
+    // Codecs for the compact text encodings of a uuid: base64url (22 characters), Crockford's base32 (26) and
+    // base58 (22). Like the hex codecs in uuid.hpp they work on the 16 raw octets, and a decoder only writes octets
+    // that are meaningful when it returns true
+
+    namespace detail
+    {
+        inline constexpr char s_base64url_alphabet[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789-_";
+        inline constexpr char s_base32_alphabet[] = "0123456789ABCDEFGHJKMNPQRSTVWXYZ";
+        inline constexpr char s_base58_alphabet[] = "123456789ABCDEFGHJKLMNPQRSTUVWXYZabcdefghijkmnopqrstuvwxyz";
+
+        /**
+         * Maps each character to its value in the alphabet, or to 0xFF if it is not in the alphabet.
+         */
+        consteval std::array<uint8_t, 256> make_decode_table(std::string_view alphabet)
+        {
+            std::array<uint8_t, 256> table{};
+            table.fill(0xFF);
+            for (size_t i = 0; i < alphabet.size(); ++i)
+            {
+                table[static_cast<uint8_t>(alphabet[i])] = static_cast<uint8_t>(i);
+            }
+
+            return table;
+        }
+
+        /**
+         * Crockford's base32 is decoded without regard to case, and reads I and L as 1 and O as 0.
+         */
+        consteval std::array<uint8_t, 256> make_base32_decode_table()
+        {
+            std::array<uint8_t, 256> table = make_decode_table(s_base32_alphabet);
+            for (char c = 'A'; c <= 'Z'; ++c)
+            {
+                table[static_cast<uint8_t>(c + ('a' - 'A'))] = table[static_cast<uint8_t>(c)];
+            }
+
+            table['I'] = table['i'] = table['L'] = table['l'] = 1;
+            table['O'] = table['o'] = 0;
+            return table;
+        }
+
+        inline constexpr std::array<uint8_t, 256> s_base64url_values = make_decode_table(s_base64url_alphabet);
+        inline constexpr std::array<uint8_t, 256> s_base32_values = make_base32_decode_table();
+        inline constexpr std::array<uint8_t, 256> s_base58_values = make_decode_table(s_base58_alphabet);
+
+        inline uint8_t base64url_value(char c) noexcept { return s_base64url_values[static_cast<uint8_t>(c)]; }
+        inline uint8_t base32_value(char c) noexcept { return s_base32_values[static_cast<uint8_t>(c)]; }
+        inline uint8_t base58_value(char c) noexcept { return s_base58_values[static_cast<uint8_t>(c)]; }
+
+        // base64url: five groups of three octets make 20 characters, and the last octet makes two more, the second of
+        // which holds two bits followed by four zero bits. There is no padding
+
+        inline void encode_base64url_scalar(uint8_t const* octets, char* out) noexcept
+        {
+            for (size_t i = 0; i < 5; ++i)
+            {
+                uint32_t const group = static_cast<uint32_t>(octets[3 * i]) << 16 | static_cast<uint32_t>(octets[3 * i + 1]) << 8 | octets[3 * i + 2];
+                out[4 * i] = s_base64url_alphabet[group >> 18];
+                out[4 * i + 1] = s_base64url_alphabet[group >> 12 & 0x3F];
+                out[4 * i + 2] = s_base64url_alphabet[group >> 6 & 0x3F];
+                out[4 * i + 3] = s_base64url_alphabet[group & 0x3F];
+            }
+
+            out[20] = s_base64url_alphabet[octets[15] >> 2];
+            out[21] = s_base64url_alphabet[(octets[15] & 0x03) << 4];
+        }
+
+        inline bool decode_base64url_scalar(char const* str, uint8_t* out) noexcept
+        {
+            uint8_t invalid = 0;
+            for (size_t i = 0; i < 5; ++i)
+            {
+                uint8_t const a = base64url_value(str[4 * i]);
+                uint8_t const b = base64url_value(str[4 * i + 1]);
+                uint8_t const c = base64url_value(str[4 * i + 2]);
+                uint8_t const d = base64url_value(str[4 * i + 3]);
+                invalid |= a | b | c | d;
+
+                uint32_t const group = static_cast<uint32_t>(a) << 18 | static_cast<uint32_t>(b) << 12 | static_cast<uint32_t>(c) << 6 | d;
+                out[3 * i] = static_cast<uint8_t>(group >> 16);
+                out[3 * i + 1] = static_cast<uint8_t>(group >> 8);
+                out[3 * i + 2] = static_cast<uint8_t>(group);
+            }
+
+            uint8_t const a = base64url_value(str[20]);
+            uint8_t const b = base64url_value(str[21]);
+            out[15] = static_cast<uint8_t>(a << 2 | (b & 0x3F) >> 4);
+
+            // The unused bits of the last character must be zero, so that every uuid has exactly one encoding
+            return ((invalid | a | b) & 0xC0) == 0 and (b & 0x0F) == 0;
+        }
+
+        // Crockford's base32: the 128 bits are read as a 130-bit number with two leading zero bits, so the first
+        // character is 0-7 and the encoding sorts like the octets (the alphabet is in ascii order)
+
+        inline void encode_base32_scalar(uint8_t const* octets, char* out) noexcept
+        {
+            uint64_t hi = 0, lo = 0;
+            for (size_t i = 0; i < 8; ++i)
+            {
+                hi = hi << 8 | octets[i];
+                lo = lo << 8 | octets[8 + i];
+            }
+
+            for (size_t i = 0; i < 26; ++i)
+            {
+                size_t const position = 5 * (25 - i);
+                uint64_t const bits = position >= 64 ? hi >> (position - 64) : (position == 0 ? lo : lo >> position | hi << (64 - position));
+                out[i] = s_base32_alphabet[bits & 0x1F];
+            }
+        }
+
+        inline bool decode_base32_scalar(char const* str, uint8_t* out) noexcept
+        {
+            uint8_t const first = base32_value(str[0]);
+            uint8_t invalid = first & 0xF8;
+
+            uint64_t hi = 0, lo = first;
+            for (size_t i = 1; i < 26; ++i)
+            {
+                uint8_t const value = base32_value(str[i]);
+                invalid |= value & 0xE0;
+
+                hi = hi << 5 | lo >> 59;
+                lo = lo << 5 | (value & 0x1F);
+            }
+
+            for (size_t i = 0; i < 8; ++i)
+            {
+                out[i] = static_cast<uint8_t>(hi >> (56 - 8 * i));
+                out[8 + i] = static_cast<uint8_t>(lo >> (56 - 8 * i));
+            }
+
+            return invalid == 0;
+        }
+
+        // base58 with the bitcoin alphabet, padded to 22 characters with the zero digit '1'. With a fixed width the
+        // encoding also sorts like the octets. The 128-bit number is held in four 32-bit limbs, most significant
+        // first, and converted five digits at a time, since 58^5 fits in 32 bits
+
+        inline constexpr uint32_t s_base58_chunk = 58u * 58u * 58u * 58u * 58u;
+
+        inline void encode_base58(uint8_t const* octets, char* out) noexcept
+        {
+            std::array<uint32_t, 4> limbs;
+            for (size_t i = 0; i < limbs.size(); ++i)
+            {
+                limbs[i] = static_cast<uint32_t>(octets[4 * i]) << 24 | static_cast<uint32_t>(octets[4 * i + 1]) << 16 | static_cast<uint32_t>(octets[4 * i + 2]) << 8 | octets[4 * i + 3];
+            }
+
+            // Four chunks of five digits from the end; what is left is less than 58^2
+            for (size_t chunk = 0; chunk < 4; ++chunk)
+            {
+                uint64_t remainder = 0;
+                for (uint32_t& limb : limbs)
+                {
+                    uint64_t const current = remainder << 32 | limb;
+                    limb = static_cast<uint32_t>(current / s_base58_chunk);
+                    remainder = current % s_base58_chunk;
+                }
+
+                auto digits = static_cast<uint32_t>(remainder);
+                for (size_t i = 0; i < 5; ++i)
+                {
+                    out[21 - 5 * chunk - i] = s_base58_alphabet[digits % 58];
+                    digits /= 58;
+                }
+            }
+
+            out[0] = s_base58_alphabet[limbs[3] / 58];
+            out[1] = s_base58_alphabet[limbs[3] % 58];
+        }
+
+        inline bool decode_base58(char const* str, uint8_t* out) noexcept
+        {
+            uint8_t invalid = 0;
+            uint8_t const d0 = base58_value(str[0]);
+            uint8_t const d1 = base58_value(str[1]);
+            invalid |= d0 | d1;
+
+            std::array<uint32_t, 4> limbs = { 0, 0, 0, static_cast<uint32_t>(d0) * 58 + d1 };
+            uint64_t overflow = 0;
+            for (size_t chunk = 0; chunk < 4; ++chunk)
+            {
+                uint32_t digits = 0;
+                for (size_t i = 0; i < 5; ++i)
+                {
+                    uint8_t const d = base58_value(str[2 + 5 * chunk + i]);
+                    invalid |= d;
+                    digits = digits * 58 + (d & 0x3F);
+                }
+
+                // limbs = limbs * 58^5 + digits, with the carry out of the top limb kept to detect overflow
+                uint64_t carry = digits;
+                for (size_t i = limbs.size(); i-- > 0;)
+                {
+                    uint64_t const product = static_cast<uint64_t>(limbs[i]) * s_base58_chunk + carry;
+                    limbs[i] = static_cast<uint32_t>(product);
+                    carry = product >> 32;
+                }
+
+                overflow |= carry;
+            }
+
+            for (size_t i = 0; i < limbs.size(); ++i)
+            {
+                out[4 * i] = static_cast<uint8_t>(limbs[i] >> 24);
+                out[4 * i + 1] = static_cast<uint8_t>(limbs[i] >> 16);
+                out[4 * i + 2] = static_cast<uint8_t>(limbs[i] >> 8);
+                out[4 * i + 3] = static_cast<uint8_t>(limbs[i]);
+            }
+
+            // Digits are 0-57, so an invalid character is the only way to set the high bits. 22 digits can hold more
+            // than 128 bits, so the value must not overflow either
+            return (invalid & 0xC0) == 0 and overflow == 0;
+        }
+
+#ifdef UUID_LIB_USE_SIMD
+        /**
+         * Maps 6-bit values to base64url characters by adding an offset per range of values, as in Wojciech Muła's
+         * base64 codecs.
+         */
+        UUID_LIB_TARGET("ssse3") inline __m128i base64url_values_to_chars(__m128i values) noexcept
+        {
+            // 0 for 26-51, 1-10 for the digits, 11 for '-', 12 for '_' and 13 for A-Z
+            __m128i const is_upper = _mm_cmpgt_epi8(_mm_set1_epi8(26), values);
+            __m128i const range = _mm_or_si128(_mm_subs_epu8(values, _mm_set1_epi8(51)), _mm_and_si128(is_upper, _mm_set1_epi8(13)));
+
+            __m128i const offsets = _mm_setr_epi8('a' - 26, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52,
+                '0' - 52, '0' - 52, '0' - 52, '-' - 62, '_' - 63, 'A', 0, 0);
+
+            return _mm_add_epi8(values, _mm_shuffle_epi8(offsets, range));
+        }
+
+        /**
+         * Splits each group of three octets into four 6-bit values. The shuffle picks the octets of each group for
+         * its 32-bit lane.
+         */
+        UUID_LIB_TARGET("ssse3") inline __m128i base64url_octets_to_values(__m128i octets, __m128i shuffle) noexcept
+        {
+            __m128i const groups = _mm_shuffle_epi8(octets, shuffle);
+            __m128i const ac = _mm_mulhi_epu16(_mm_and_si128(groups, _mm_set1_epi32(0x0FC0FC00)), _mm_set1_epi32(0x04000040));
+            __m128i const bd = _mm_mullo_epi16(_mm_and_si128(groups, _mm_set1_epi32(0x003F03F0)), _mm_set1_epi32(0x01000010));
+            return _mm_or_si128(ac, bd);
+        }
+
+        UUID_LIB_TARGET("ssse3") inline void encode_base64url_ssse3(uint8_t const* octets, char* out) noexcept
+        {
+            __m128i const in = _mm_loadu_si128(reinterpret_cast<__m128i const*>(octets));
+
+            // Characters 0-15 come from octets 0-11, characters 16-21 from octets 12-15 and two zero octets
+            __m128i const first = base64url_values_to_chars(base64url_octets_to_values(in,
+                _mm_setr_epi8(1, 0, 2, 1, 4, 3, 5, 4, 7, 6, 8, 7, 10, 9, 11, 10)));
+            __m128i const second = base64url_values_to_chars(base64url_octets_to_values(in,
+                _mm_setr_epi8(13, 12, 14, 13, -1, 15, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1)));
+
+            // Two overlapping stores write exactly 22 characters
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(out), first);
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(out + 6), _mm_or_si128(_mm_srli_si128(first, 6), _mm_slli_si128(second, 10)));
+        }
+
+        /**
+         * Maps base64url characters to their 6-bit values. Lanes that do not hold a base64url character are flagged
+         * in the returned validity mask.
+         */
+        UUID_LIB_TARGET("ssse3") inline __m128i base64url_chars_to_values(__m128i chars, __m128i& valid) noexcept
+        {
+            __m128i const upper = _mm_sub_epi8(chars, _mm_set1_epi8('A'));
+            __m128i const lower = _mm_sub_epi8(chars, _mm_set1_epi8('a'));
+            __m128i const digit = _mm_sub_epi8(chars, _mm_set1_epi8('0'));
+
+            __m128i const is_upper = _mm_cmpeq_epi8(_mm_min_epu8(upper, _mm_set1_epi8(25)), upper);
+            __m128i const is_lower = _mm_cmpeq_epi8(_mm_min_epu8(lower, _mm_set1_epi8(25)), lower);
+            __m128i const is_digit = _mm_cmpeq_epi8(_mm_min_epu8(digit, _mm_set1_epi8(9)), digit);
+            __m128i const is_dash = _mm_cmpeq_epi8(chars, _mm_set1_epi8('-'));
+            __m128i const is_underscore = _mm_cmpeq_epi8(chars, _mm_set1_epi8('_'));
+
+            valid = _mm_or_si128(_mm_or_si128(is_upper, is_lower), _mm_or_si128(_mm_or_si128(is_digit, is_dash), is_underscore));
+
+            return _mm_or_si128(
+                _mm_or_si128(_mm_and_si128(is_upper, upper), _mm_and_si128(is_lower, _mm_add_epi8(lower, _mm_set1_epi8(26)))),
+                _mm_or_si128(
+                    _mm_and_si128(is_digit, _mm_add_epi8(digit, _mm_set1_epi8(52))),
+                    _mm_or_si128(_mm_and_si128(is_dash, _mm_set1_epi8(62)), _mm_and_si128(is_underscore, _mm_set1_epi8(63)))));
+        }
+
+        /**
+         * Joins each four 6-bit values into a 24-bit group, held big endian in the low three octets of its 32-bit
+         * lane.
+         */
+        UUID_LIB_TARGET("ssse3") inline __m128i base64url_values_to_groups(__m128i values) noexcept
+        {
+            __m128i const pairs = _mm_maddubs_epi16(values, _mm_set1_epi32(0x01400140));
+            return _mm_madd_epi16(pairs, _mm_set1_epi32(0x00011000));
+        }
+
+        UUID_LIB_TARGET("ssse3") inline bool decode_base64url_ssse3(char const* str, uint8_t* out) noexcept
+        {
+            // Characters 16-21 are loaded with the ones before them and moved down, and the lanes after them are
+            // filled with 'A', which is zero
+            __m128i const first_chars = _mm_loadu_si128(reinterpret_cast<__m128i const*>(str));
+            __m128i const second_chars = _mm_or_si128(
+                _mm_srli_si128(_mm_loadu_si128(reinterpret_cast<__m128i const*>(str + 6)), 10),
+                _mm_setr_epi8(0, 0, 0, 0, 0, 0, 'A', 'A', 'A', 'A', 'A', 'A', 'A', 'A', 'A', 'A'));
+
+            __m128i first_valid, second_valid;
+            __m128i const first = base64url_values_to_groups(base64url_chars_to_values(first_chars, first_valid));
+            __m128i const second = base64url_values_to_groups(base64url_chars_to_values(second_chars, second_valid));
+
+            __m128i const octets = _mm_or_si128(
+                _mm_shuffle_epi8(first, _mm_setr_epi8(2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1)),
+                _mm_shuffle_epi8(second, _mm_setr_epi8(-1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 2, 1, 0, 6)));
+
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(out), octets);
+
+            // The octet after the last one must be zero, as for the scalar decoder
+            bool const canonical = (_mm_extract_epi16(second, 2) & 0xFF00) == 0;
+            return _mm_movemask_epi8(_mm_and_si128(first_valid, second_valid)) == 0xFFFF and canonical;
+        }
+
+        /**
+         * For each of the 26 base32 characters, the two octets whose bits it is in, and the power of two that moves
+         * its five bits to the top of the 16-bit lane. Character i is bits 5i - 2 to 5i + 2 of the octets, counted
+         * from the most significant bit; the first character only has three bits.
+         */
+        struct base32_layout
+        {
+            alignas(16) std::array<int8_t, 64> shuffle;
+            alignas(16) std::array<uint16_t, 32> multipliers;
+        };
+
+        consteval base32_layout make_base32_layout()
+        {
+            base32_layout layout{};
+            for (int i = 0; i < 32; ++i)
+            {
+                int const first_bit = 5 * i - 2;
+                int const octet = first_bit < 0 ? -1 : first_bit / 8;
+                int const shift = first_bit - 8 * octet;
+
+                // Little endian lanes: the low byte is the second octet
+                bool const used = i < 26;
+                layout.shuffle[2 * i] = static_cast<int8_t>(used and octet + 1 < 16 ? octet + 1 : -1);
+                layout.shuffle[2 * i + 1] = static_cast<int8_t>(used and octet >= 0 ? octet : -1);
+                layout.multipliers[i] = static_cast<uint16_t>(used ? 1 << shift : 0);
+            }
+
+            return layout;
+        }
+
+        inline constexpr base32_layout s_base32_layout = make_base32_layout();
+
+        UUID_LIB_TARGET("ssse3") inline __m128i base32_values(__m128i octets, size_t lane_group) noexcept
+        {
+            __m128i const shuffle = _mm_load_si128(reinterpret_cast<__m128i const*>(s_base32_layout.shuffle.data() + 16 * lane_group));
+            __m128i const multipliers = _mm_load_si128(reinterpret_cast<__m128i const*>(s_base32_layout.multipliers.data() + 8 * lane_group));
+            return _mm_srli_epi16(_mm_mullo_epi16(_mm_shuffle_epi8(octets, shuffle), multipliers), 11);
+        }
+
+        UUID_LIB_TARGET("ssse3") inline __m128i base32_values_to_chars(__m128i values) noexcept
+        {
+            __m128i const low = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<__m128i const*>(s_base32_alphabet)), values);
+            __m128i const high = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<__m128i const*>(s_base32_alphabet + 16)), values);
+            __m128i const is_high = _mm_cmpgt_epi8(values, _mm_set1_epi8(15));
+            return _mm_or_si128(_mm_and_si128(is_high, high), _mm_andnot_si128(is_high, low));
+        }
+
+        UUID_LIB_TARGET("ssse3") inline void encode_base32_ssse3(uint8_t const* octets, char* out) noexcept
+        {
+            __m128i const in = _mm_loadu_si128(reinterpret_cast<__m128i const*>(octets));
+
+            __m128i const first = base32_values_to_chars(_mm_packus_epi16(base32_values(in, 0), base32_values(in, 1)));
+            __m128i const second = base32_values_to_chars(_mm_packus_epi16(base32_values(in, 2), base32_values(in, 3)));
+
+            // Characters 0-15, then 10-25
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(out), first);
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(out + 10), _mm_or_si128(_mm_srli_si128(first, 10), _mm_slli_si128(second, 6)));
+        }
+
+        /**
+         * Maps base32 characters to their values. Characters that are not in the alphabet map to values with the
+         * high bit set.
+         */
+        UUID_LIB_TARGET("ssse3") inline __m128i base32_chars_to_values(__m128i chars) noexcept
+        {
+            __m128i const digit = _mm_sub_epi8(chars, _mm_set1_epi8('0'));
+            __m128i const letter = _mm_sub_epi8(_mm_or_si128(chars, _mm_set1_epi8(0x20)), _mm_set1_epi8('a'));
+
+            __m128i const is_digit = _mm_cmpeq_epi8(_mm_min_epu8(digit, _mm_set1_epi8(9)), digit);
+            __m128i const is_letter = _mm_cmpeq_epi8(_mm_min_epu8(letter, _mm_set1_epi8(25)), letter);
+
+            // The letters A-P and Q-Z, with the aliases I, L and O and with U invalid
+            __m128i const first_letters = _mm_setr_epi8(10, 11, 12, 13, 14, 15, 16, 17, 1, 18, 19, 1, 20, 21, 0, 22);
+            __m128i const last_letters = _mm_setr_epi8(23, 24, 25, 26, -1, 27, 28, 29, 30, 31, -1, -1, -1, -1, -1, -1);
+            __m128i const is_last = _mm_cmpgt_epi8(letter, _mm_set1_epi8(15));
+            __m128i const letter_value = _mm_or_si128(
+                _mm_andnot_si128(is_last, _mm_shuffle_epi8(first_letters, letter)),
+                _mm_and_si128(is_last, _mm_shuffle_epi8(last_letters, _mm_and_si128(letter, _mm_set1_epi8(0x0F)))));
+
+            return _mm_or_si128(
+                _mm_or_si128(_mm_and_si128(is_digit, digit), _mm_and_si128(is_letter, letter_value)),
+                _mm_andnot_si128(_mm_or_si128(is_digit, is_letter), _mm_set1_epi8(-1)));
+        }
+
+        /**
+         * Joins each eight 5-bit values into 40 bits, held in the low five octets of its 64-bit lane.
+         */
+        UUID_LIB_TARGET("ssse3") inline __m128i base32_values_to_groups(__m128i values) noexcept
+        {
+            __m128i const pairs = _mm_maddubs_epi16(values, _mm_set1_epi16(0x0120));
+            __m128i const quads = _mm_madd_epi16(pairs, _mm_set1_epi32(0x00010400));
+            return _mm_or_si128(_mm_srli_epi64(quads, 32), _mm_slli_epi64(_mm_and_si128(quads, _mm_set1_epi64x(0xFFFFFFFF)), 20));
+        }
+
+        UUID_LIB_TARGET("ssse3") inline bool decode_base32_ssse3(char const* str, uint8_t* out) noexcept
+        {
+            // Characters 16-25 are loaded with the ones before them and moved down, and the lanes after them are
+            // filled with '0'
+            __m128i const first = base32_chars_to_values(_mm_loadu_si128(reinterpret_cast<__m128i const*>(str)));
+            __m128i const second = base32_chars_to_values(_mm_or_si128(
+                _mm_srli_si128(_mm_loadu_si128(reinterpret_cast<__m128i const*>(str + 10)), 6),
+                _mm_setr_epi8(0, 0, 0, 0, 0, 0, 0, 0, 0, 0, '0', '0', '0', '0', '0', '0')));
+
+            // Characters 0 and 1 make octet 0, and each eight characters after them make five octets
+            __m128i const groups_1_10 = base32_values_to_groups(_mm_alignr_epi8(second, first, 2));
+            __m128i const groups_11_15 = base32_values_to_groups(_mm_srli_si128(second, 2));
+
+            uint32_t const head = static_cast<uint32_t>(_mm_cvtsi128_si32(first));
+            uint32_t const first_value = head & 0xFF;
+            uint32_t const octet_0 = first_value << 5 | (head >> 8 & 0x1F);
+
+            __m128i const octets = _mm_or_si128(
+                _mm_or_si128(
+                    _mm_shuffle_epi8(groups_1_10, _mm_setr_epi8(-1, 4, 3, 2, 1, 0, 12, 11, 10, 9, 8, -1, -1, -1, -1, -1)),
+                    _mm_shuffle_epi8(groups_11_15, _mm_setr_epi8(-1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 4, 3, 2, 1, 0))),
+                _mm_cvtsi32_si128(static_cast<int>(octet_0 & 0xFF)));
+
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(out), octets);
+
+            // Invalid characters have the high bit set, and the first character holds only three bits
+            return _mm_movemask_epi8(_mm_or_si128(first, second)) == 0 and first_value <= 7;
+        }
+#endif
+
+        inline void encode_base64url(uint8_t const* octets, char* out) noexcept
+        {
+#ifdef UUID_LIB_USE_SIMD
+            if (has_ssse3())
+            {
+                encode_base64url_ssse3(octets, out);
+                return;
+            }
+#endif
+            encode_base64url_scalar(octets, out);
+        }
+
+        inline bool decode_base64url(char const* str, uint8_t* out) noexcept
+        {
+#ifdef UUID_LIB_USE_SIMD
+            if (has_ssse3())
+            {
+                return decode_base64url_ssse3(str, out);
+            }
+#endif
+            return decode_base64url_scalar(str, out);
+        }
+
+        inline void encode_base32(uint8_t const* octets, char* out) noexcept
+        {
+#ifdef UUID_LIB_USE_SIMD
+            if (has_ssse3())
+            {
+                encode_base32_ssse3(octets, out);
+                return;
+            }
+#endif
+            encode_base32_scalar(octets, out);
+        }
+
+        inline bool decode_base32(char const* str, uint8_t* out) noexcept
+        {
+#ifdef UUID_LIB_USE_SIMD
+            if (has_ssse3())
+            {
+                return decode_base32_ssse3(str, out);
+            }
+#endif
+            return decode_base32_scalar(str, out);
+        }
+    }
+}
@@ -1,16 +1,194 @@
 #pragma once
 
+#include <algorithm>
+#include <array>
 #include <cstdint>
+#include <iterator>
+#include <span>
+#include <string_view>
+#include <thread>
 #include <vector>
 #include <chrono>
 
 #include "uuid.hpp"
+#include "uuid_clock.hpp"
+#include "uuid_name.hpp"
+#include "uuid_sequencer.hpp"
+#include "uuid_v8.hpp"
+#include "uuid_view.hpp"
+#include "xoroshiro128.hpp"
 
 namespace LambdaSnail::Uuid
 {
-    template<typename rng_t>
+    namespace detail
+    {
+        /**
+         * Turns random numbers into increments in [1, max_increment] and writes their running sum:
+         * out[i] = start + increment[0] + ... + increment[i]. An increment is 1 + (random * max_increment) / 2^32,
+         * which needs no division. Returns the last sum, or start if count is zero.
+         */
+        inline uint64_t accumulate_increments_baseline(uint32_t const* random, size_t count, uint32_t max_increment, uint64_t start, uint64_t* out) noexcept
+        {
+            uint64_t sum = start;
+            for (size_t i = 0; i < count; ++i)
+            {
+                sum += 1 + (static_cast<uint64_t>(random[i]) * max_increment >> 32);
+                out[i] = sum;
+            }
+
+            return sum;
+        }
+
+#ifdef UUID_LIB_USE_SIMD
+        // The vector versions compute the prefix sum of each register in log2(lanes) shift-and-add steps, and then add
+        // the last sum of the previous register, broadcast to all lanes
+
+        UUID_LIB_TARGET("avx512f") inline uint64_t accumulate_increments_avx512(uint32_t const* random, size_t count, uint32_t max_increment, uint64_t start, uint64_t* out) noexcept
+        {
+            __m512i const scale = _mm512_set1_epi64(max_increment);
+            __m512i const one = _mm512_set1_epi64(1);
+            __m512i const zero = _mm512_setzero_si512();
+            __m512i const last_lane = _mm512_set1_epi64(7);
+            __m512i carry = _mm512_set1_epi64(static_cast<int64_t>(start));
+
+            size_t i = 0;
+            for (; i + 8 <= count; i += 8)
+            {
+                __m512i const r = _mm512_cvtepu32_epi64(_mm256_loadu_si256(reinterpret_cast<__m256i const*>(random + i)));
+                __m512i x = _mm512_add_epi64(_mm512_srli_epi64(_mm512_mul_epu32(r, scale), 32), one);
+
+                // alignr with zero shifts the lanes up by one, two and four
+                x = _mm512_add_epi64(x, _mm512_alignr_epi64(x, zero, 7));
+                x = _mm512_add_epi64(x, _mm512_alignr_epi64(x, zero, 6));
+                x = _mm512_add_epi64(x, _mm512_alignr_epi64(x, zero, 4));
+                x = _mm512_add_epi64(x, carry);
+
+                _mm512_storeu_si512(out + i, x);
+                carry = _mm512_permutexvar_epi64(last_lane, x);
+            }
+
+            uint64_t const sum = i == 0 ? start : out[i - 1];
+            return accumulate_increments_baseline(random + i, count - i, max_increment, sum, out + i);
+        }
+
+        UUID_LIB_TARGET("avx2") inline uint64_t accumulate_increments_avx2(uint32_t const* random, size_t count, uint32_t max_increment, uint64_t start, uint64_t* out) noexcept
+        {
+            __m256i const scale = _mm256_set1_epi64x(max_increment);
+            __m256i const one = _mm256_set1_epi64x(1);
+            __m256i const zero = _mm256_setzero_si256();
+            __m256i carry = _mm256_set1_epi64x(static_cast<int64_t>(start));
+
+            size_t i = 0;
+            for (; i + 4 <= count; i += 4)
+            {
+                __m256i const r = _mm256_cvtepu32_epi64(_mm_loadu_si128(reinterpret_cast<__m128i const*>(random + i)));
+                __m256i x = _mm256_add_epi64(_mm256_srli_epi64(_mm256_mul_epu32(r, scale), 32), one);
+
+                // Rotate the lanes up by one and two, and zero the lanes that wrapped around
+                x = _mm256_add_epi64(x, _mm256_blend_epi32(_mm256_permute4x64_epi64(x, _MM_SHUFFLE(2, 1, 0, 3)), zero, 0x03));
+                x = _mm256_add_epi64(x, _mm256_blend_epi32(_mm256_permute4x64_epi64(x, _MM_SHUFFLE(1, 0, 3, 2)), zero, 0x0F));
+                x = _mm256_add_epi64(x, carry);
+
+                _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i), x);
+                carry = _mm256_permute4x64_epi64(x, _MM_SHUFFLE(3, 3, 3, 3));
+            }
+
+            uint64_t const sum = i == 0 ? start : out[i - 1];
+            return accumulate_increments_baseline(random + i, count - i, max_increment, sum, out + i);
+        }
+#endif
+
+        /**
+         * Writes the octets of copies of the prototype with rand_b set to each counter, in big endian and with the
+         * variant bits, to raw memory with room for count * 16 bytes.
+         */
+        inline void set_v7_counters_baseline(uuid const& prototype, uint64_t const* counters, size_t count, uint8_t* out) noexcept
+        {
+            for (size_t i = 0; i < count; ++i, out += sizeof(uuid::octet_set_t))
+            {
+                uint64_t const rand_b = (counters[i] | static_cast<uint64_t>(1) << 63) & ~(static_cast<uint64_t>(1) << 62);
+
+                memcpy(out, prototype.octets.data(), sizeof(uint64_t));
+                for (size_t k = 0; k < sizeof(uint64_t); ++k)
+                {
+                    out[15 - k] = static_cast<uint8_t>(rand_b >> 8 * k);
+                }
+            }
+        }
+
+#ifdef UUID_LIB_USE_SIMD
+        UUID_LIB_TARGET("avx2") inline void set_v7_counters_avx2(uuid const& prototype, uint64_t const* counters, size_t count, uint8_t* out) noexcept
+        {
+            uint64_t upper;
+            memcpy(&upper, prototype.octets.data(), sizeof(uint64_t));
+
+            __m256i const upper_v = _mm256_set1_epi64x(static_cast<int64_t>(upper));
+            __m256i const variant_and = _mm256_set1_epi64x(~(static_cast<int64_t>(1) << 62));
+            __m256i const variant_or = _mm256_set1_epi64x(static_cast<int64_t>(static_cast<uint64_t>(1) << 63));
+            __m256i const to_big_endian = _mm256_setr_epi8(
+                7, 6, 5, 4, 3, 2, 1, 0, 15, 14, 13, 12, 11, 10, 9, 8,
+                7, 6, 5, 4, 3, 2, 1, 0, 15, 14, 13, 12, 11, 10, 9, 8);
+
+            size_t i = 0;
+            for (; i + 4 <= count; i += 4)
+            {
+                __m256i x = _mm256_loadu_si256(reinterpret_cast<__m256i const*>(counters + i));
+                x = _mm256_shuffle_epi8(_mm256_or_si256(_mm256_and_si256(x, variant_and), variant_or), to_big_endian);
+
+                // Pair each counter with the upper half of the prototype: [u, c0, u, c2] and [u, c1, u, c3], then
+                // reorder the 128-bit lanes into uuids 0, 1 and 2, 3
+                __m256i const even = _mm256_unpacklo_epi64(upper_v, x);
+                __m256i const odd = _mm256_unpackhi_epi64(upper_v, x);
+                _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + 16 * i), _mm256_permute2x128_si256(even, odd, 0x20));
+                _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + 16 * i + 32), _mm256_permute2x128_si256(even, odd, 0x31));
+            }
+
+            set_v7_counters_baseline(prototype, counters + i, count - i, out + 16 * i);
+        }
+#endif
+
+        inline void set_v7_counters(uuid const& prototype, uint64_t const* counters, size_t count, uint8_t* out) noexcept
+        {
+#ifdef UUID_LIB_USE_SIMD
+            if (has_avx2())
+            {
+                set_v7_counters_avx2(prototype, counters, count, out);
+                return;
+            }
+#endif
+            set_v7_counters_baseline(prototype, counters, count, out);
+        }
+
+        inline uint64_t accumulate_increments(uint32_t const* random, size_t count, uint32_t max_increment, uint64_t start, uint64_t* out) noexcept
+        {
+#ifdef UUID_LIB_USE_SIMD
+            if (has_avx512f())
+            {
+                return accumulate_increments_avx512(random, count, max_increment, start, out);
+            }
+
+            if (has_avx2())
+            {
+                return accumulate_increments_avx2(random, count, max_increment, start, out);
+            }
+#endif
+            return accumulate_increments_baseline(random, count, max_increment, start, out);
+        }
+    }
+
+    /**
+     * Creates uuids from a random number generator and, for v7, a clock.
+     * @tparam rng_t The type of the random number generator.
+     * @tparam clock_policy_t Where v7 timestamps are read from, see uuid_clock.hpp. Defaults to std::chrono::system_clock.
+     */
+    template<typename rng_t, uuid_clock clock_policy_t = system_clock_policy>
     struct uuid_factory
     {
+        /**
+         * How far create_uuids_rolling_counter lets the timestamp run ahead of the clock by default.
+         */
+        static inline constexpr std::chrono::milliseconds s_default_max_skew = std::chrono::milliseconds(10);
+
         /**
          * Creates a single version four uuid based on the provided random number generator.
          * @tparam rng_t The type of the random number generator. This needs to provide the member function `next()`.
@@ -18,6 +196,15 @@ namespace LambdaSnail::Uuid
          */
         void create_uuid_v4(uuid& out_id) noexcept;
 
+        /**
+         * Fills the span with version four uuids. The random bits come from eight xoroshiro128++ generators stepped
+         * side by side, which run in parallel in one AVX-512 register or two AVX2 registers on cpus that have them.
+         * These lanes are seeded from the factory generator on the first call, so the uuids are only as random as
+         * xoroshiro128++ regardless of rng_t.
+         * @param out_ids The output uuids.
+         */
+        void create_uuids_v4(std::span<uuid> out_ids) noexcept;
+
         /**
          * Creates a single version seven uuid based on the provided random number generator.
          * @tparam rng_t The type of the random number generator. This needs to provide the member function `next()`.
@@ -25,20 +212,214 @@ namespace LambdaSnail::Uuid
          */
         void create_uuid_v7(uuid& out_id) noexcept;
 
+        /**
+         * Creates a single version seven uuid that is strictly greater than the previous one created with this function
+         * on the same factory (method 3 in section 6.2 of the RFC).
+         *
+         * The 12 bits of rand_a hold the fraction of the millisecond, in steps of 1/4096 ms (about 244 ns). The factory
+         * remembers the last timestamp and fraction it issued. If the clock has not moved past them, either because
+         * the uuids are created faster than the clock ticks or because the clock was set backwards, the last value is
+         * incremented by one step instead. The timestamp may then run slightly ahead of the clock until it catches up.
+         * rand_b is random.
+         *
+         * @param out_id The output uuid.
+         */
+        void create_uuid_v7_monotonic(uuid& out_id) noexcept;
+
+        /**
+         * Fills the span with strictly increasing version seven uuids, continuing the sequence of
+         * create_uuid_v7_monotonic. The clock is read once, and the uuids take consecutive sub-millisecond steps
+         * from there (or from the last uuid issued, if the clock has not moved past it).
+         * @param out_ids The output uuids.
+         */
+        void create_uuids_v7_monotonic(std::span<uuid> out_ids) noexcept;
+
+        /**
+         * Returns an infinite range of version four uuids, created block_size at a time with create_uuids_v4. The
+         * factory must outlive the view.
+         *
+         * For example, `for (uuid const& id : factory.v4_view() | std::views::take(1000))`.
+         */
+        template<size_t block_size = 256>
+        [[nodiscard]] auto v4_view();
+
+        /**
+         * Returns an infinite range of strictly increasing version seven uuids, created block_size at a time with
+         * create_uuids_v7_monotonic. The factory must outlive the view.
+         *
+         * The timestamps are taken when a block is created, so a uuid that is consumed long after the others in its
+         * block carries an older timestamp.
+         */
+        template<size_t block_size = 256>
+        [[nodiscard]] auto v7_view();
+
+        /**
+         * Creates a single version seven uuid from the next slot of a sequencer that may be shared with other threads
+         * and factories. The uuid is greater than every uuid created from the same sequencer before it. rand_b is
+         * random.
+         * @param sequencer The sequencer to claim the timestamp and rand_a from.
+         * @param out_id The output uuid.
+         */
+        template<shared_uuid_clock sequencer_clock_t>
+        void create_uuid_v7(v7_sequencer<sequencer_clock_t>& sequencer, uuid& out_id) noexcept;
+
+        /**
+         * Fills the span with consecutive, increasing version seven uuids, claimed from the sequencer with a single
+         * atomic operation. rand_b is random.
+         * @param sequencer The sequencer to claim the timestamps and rand_a from.
+         * @param out_ids The output uuids.
+         */
+        template<shared_uuid_clock sequencer_clock_t>
+        void create_uuids_v7(v7_sequencer<sequencer_clock_t>& sequencer, std::span<uuid> out_ids) noexcept;
+
+        /**
+         * Creates a single version eight uuid with a timestamp and a shard id in the bits given by the layout, and
+         * random data in the remaining bits. The shard id can be read back with layout_t::shard.
+         * @tparam layout_t A v8_layout.
+         * @param shard The shard (or node) id. Bits above the width of the shard field are dropped.
+         * @param out_id The output uuid.
+         */
+        template<typename layout_t>
+        void create_uuid_v8(uint64_t shard, uuid& out_id) noexcept;
+
+        /**
+         * Fills the span with version eight uuids for one shard, see above. The clock is read once for the whole
+         * batch, and the random bits are drawn with the same generator lanes as create_uuids_v4.
+         * @tparam layout_t A v8_layout.
+         * @param shard The shard (or node) id.
+         * @param out_ids The output uuids.
+         */
+        template<typename layout_t>
+        void create_uuids_v8(uint64_t shard, std::span<uuid> out_ids) noexcept;
+
+        /**
+         * Appends version eight uuids for one shard to the vector, see above.
+         * @tparam layout_t A v8_layout.
+         * @param num_uuids The number of uuids to create.
+         * @param shard The shard (or node) id.
+         * @param out_vec The vector to append the generated uuids to.
+         */
+        template<typename layout_t>
+        void create_uuids_v8(uint32_t num_uuids, uint64_t shard, std::vector<uuid>& out_vec) noexcept;
+
+        /**
+         * Creates a version five uuid from a name in a name space, such as namespace_dns or namespace_url. The uuid
+         * is the SHA-1 hash of the name space and the name, so the same name always gives the same uuid. This is
+         * useful to derive ids from natural keys. The hash uses the SHA extensions when the processor has them.
+         * @param name_space The uuid of the name space.
+         * @param name The name, in whatever canonical form the name space uses.
+         * @param out_id The output uuid.
+         */
+        void create_uuid_v5(uuid const& name_space, std::string_view name, uuid& out_id) const noexcept;
+
+        /**
+         * Creates version five uuids for many names in one name space. With AVX-512, or with AVX2 and no SHA
+         * extensions, the names are hashed side by side, one per 32-bit lane of a vector register.
+         * @param name_space The uuid of the name space.
+         * @param names The names.
+         * @param out_ids The output uuids, one per name. Must be at least as long as names.
+         */
+        void create_uuids_v5(uuid const& name_space, std::span<std::string_view const> names, std::span<uuid> out_ids) const noexcept;
+
+        /**
+         * Creates a version three uuid from a name in a name space, like create_uuid_v5 but with MD5. Prefer
+         * version five unless an existing system expects version three.
+         * @param name_space The uuid of the name space.
+         * @param name The name.
+         * @param out_id The output uuid.
+         */
+        void create_uuid_v3(uuid const& name_space, std::string_view name, uuid& out_id) const noexcept;
+
+        /**
+         * Creates version three uuids for many names in one name space.
+         * @param name_space The uuid of the name space.
+         * @param names The names.
+         * @param out_ids The output uuids, one per name. Must be at least as long as names.
+         */
+        void create_uuids_v3(uuid const& name_space, std::span<std::string_view const> names, std::span<uuid> out_ids) const noexcept;
+
         /**
          * Creates a number of uuids using a fixed bit-length dedicated counter. Using this method, up to
          * 4096 UUIDs can be created with the same millisecond timestamp. This function is limited in that
          * it should only be called once per millisecond.
          *
          * Note that no checks are performed on the input - it is up to the user to not request more than 4096 uuids. If
-         * you need a million uuids in one batch, see create_uuids_monotonic_random.
+         * you need a million uuids in one batch, see create_uuids_monotonic_random or create_uuids_rolling_counter.
          *
          * @tparam rng_t The type of the random generator to be used. Defaults to xoroshiro128pp that comes bundled with the library.
          * @param num_uuids The number of uuids to create.
-         * @param out_vec The vector to place the generated uuids in.
+         * @param out_vec The vector to append the generated uuids to.
          */
         void create_uuids_dedicated_counter(uint16_t num_uuids, std::vector<uuid>& out_vec) noexcept;
 
+        /**
+         * Fills the span with uuids using a dedicated counter, see above. The span must hold at most 4096 uuids.
+         * @param out_ids The output uuids.
+         */
+        void create_uuids_dedicated_counter(std::span<uuid> out_ids) noexcept;
+
+        /**
+         * Writes uuids created with a dedicated counter, see above, to an output iterator.
+         * @param num_uuids The number of uuids to create.
+         * @param out The output iterator.
+         * @return The output iterator after the last uuid.
+         */
+        template<std::output_iterator<uuid const&> out_it_t>
+        out_it_t create_uuids_dedicated_counter(uint16_t num_uuids, out_it_t out) noexcept;
+
+        /**
+         * Writes the octets of uuids created with a dedicated counter, see above, to raw memory, such as an arena or
+         * a memory-mapped file. No uuid objects are constructed.
+         * @param num_uuids The number of uuids to create.
+         * @param out The output memory. Must have room for num_uuids * 16 bytes.
+         */
+        void create_uuids_dedicated_counter(uint16_t num_uuids, void* out) noexcept;
+
+        /**
+         * Creates a number of uuids using a dedicated counter in rand_a, like create_uuids_dedicated_counter, but
+         * without its limits. When the 4096 values of the counter are used up, the timestamp is moved one millisecond
+         * ahead of the clock and the counter starts over, so a batch may hold any number of uuids. The position in the
+         * sequence is kept between calls (and shared with create_uuid_v7_monotonic), so every uuid is greater than
+         * all uuids the factory created before with these functions, however often they are called per millisecond.
+         *
+         * The timestamp is not allowed to run more than max_skew ahead of the clock. If a batch gets there, the
+         * function waits (yielding the thread) until the clock catches up, which limits the rate to 4096 uuids per
+         * millisecond over the long run. If the clock was set backwards, the timestamp keeps running ahead of it, and
+         * a batch only waits for the skew it adds itself.
+         *
+         * @param num_uuids The number of uuids to create.
+         * @param out_vec The vector to append the generated uuids to.
+         * @param max_skew How far the timestamp may run ahead of the clock.
+         */
+        void create_uuids_rolling_counter(uint32_t num_uuids, std::vector<uuid>& out_vec, std::chrono::milliseconds max_skew = s_default_max_skew) noexcept;
+
+        /**
+         * Fills the span with uuids using a rolling dedicated counter, see above. The span must hold fewer than 2^32
+         * uuids.
+         * @param out_ids The output uuids.
+         * @param max_skew How far the timestamp may run ahead of the clock.
+         */
+        void create_uuids_rolling_counter(std::span<uuid> out_ids, std::chrono::milliseconds max_skew = s_default_max_skew) noexcept;
+
+        /**
+         * Writes uuids created with a rolling dedicated counter, see above, to an output iterator.
+         * @param num_uuids The number of uuids to create.
+         * @param out The output iterator.
+         * @param max_skew How far the timestamp may run ahead of the clock.
+         * @return The output iterator after the last uuid.
+         */
+        template<std::output_iterator<uuid const&> out_it_t>
+        out_it_t create_uuids_rolling_counter(uint32_t num_uuids, out_it_t out, std::chrono::milliseconds max_skew = s_default_max_skew) noexcept;
+
+        /**
+         * Writes the octets of uuids created with a rolling dedicated counter, see above, to raw memory. No uuid
+         * objects are constructed.
+         * @param num_uuids The number of uuids to create.
+         * @param out The output memory. Must have room for num_uuids * 16 bytes.
+         * @param max_skew How far the timestamp may run ahead of the clock.
+         */
+        void create_uuids_rolling_counter(uint32_t num_uuids, void* out, std::chrono::milliseconds max_skew = s_default_max_skew) noexcept;
+
         /**
          * Creates a number of uuids using a monotonic random counter. This is the second way specified in the standard for generating
          * monotonically increasing UUIDs. It works by utilizing the 64 bit random data in octets 8-15 as a counter. This allows the creation
@@ -49,32 +430,183 @@ namespace LambdaSnail::Uuid
          * - Finally the uuids are generated sequentially, incrementing the counter in octets 8-15 after each iteration.
          *
          * Note that this way of creating UUIDs should not be used when security or the ability to guess the next id is a concern.
+         * The uuids are only guaranteed to be increasing if num_uuids * increment is less than 2^62.
          *
          * @tparam rng_t The type of the random generator to be used. Defaults to xoroshiro128pp that comes bundled with the library.
          * @param num_uuids The number of uuids to create.
          * @param increment The increment between each uuid. Each new uuid will be larger than the previous by this amount.
-         * @param out_vec The vector to place the generated uuids in.
+         * @param out_vec The vector to append the generated uuids to.
          */
         void create_uuids_monotonic_random(uint32_t num_uuids, uint32_t increment, std::vector<uuid>& out_vec) noexcept;
 
+        /**
+         * Fills the span with uuids using a monotonic random counter, see above. The span must hold fewer than 2^32
+         * uuids.
+         * @param out_ids The output uuids.
+         * @param increment The increment between each uuid.
+         */
+        void create_uuids_monotonic_random(std::span<uuid> out_ids, uint32_t increment) noexcept;
+
+        /**
+         * Writes uuids created with a monotonic random counter, see above, to an output iterator.
+         * @param num_uuids The number of uuids to create.
+         * @param increment The increment between each uuid.
+         * @param out The output iterator.
+         * @return The output iterator after the last uuid.
+         */
+        template<std::output_iterator<uuid const&> out_it_t>
+        out_it_t create_uuids_monotonic_random(uint32_t num_uuids, uint32_t increment, out_it_t out) noexcept;
+
+        /**
+         * Writes the octets of uuids created with a monotonic random counter, see above, to raw memory. No uuid
+         * objects are constructed.
+         * @param num_uuids The number of uuids to create.
+         * @param increment The increment between each uuid.
+         * @param out The output memory. Must have room for num_uuids * 16 bytes.
+         */
+        void create_uuids_monotonic_random(uint32_t num_uuids, uint32_t increment, void* out) noexcept;
+
+        /**
+         * Creates a number of uuids using a monotonic random counter, like create_uuids_monotonic_random, but adds a
+         * random increment between 1 and max_increment (inclusive) at each step instead of a fixed one. This is the
+         * random increment suggested for method 2 in section 6.2 of the RFC, and makes the next uuid in a batch much
+         * harder to guess from the previous one.
+         *
+         * The increments are drawn in bulk from the same generator lanes as create_uuids_v4, and summed with a vector
+         * prefix sum when AVX2 or AVX-512 is available.
+         *
+         * The uuids are only guaranteed to be increasing if num_uuids * max_increment is less than 2^62.
+         *
+         * @param num_uuids The number of uuids to create.
+         * @param max_increment The largest increment between two uuids. Must be at least one.
+         * @param out_vec The vector to append the generated uuids to.
+         */
+        void create_uuids_random_increment(uint32_t num_uuids, uint32_t max_increment, std::vector<uuid>& out_vec) noexcept;
+
+        /**
+         * Fills the span with uuids using a random increment, see above. The span must hold fewer than 2^32 uuids.
+         * @param out_ids The output uuids.
+         * @param max_increment The largest increment between two uuids.
+         */
+        void create_uuids_random_increment(std::span<uuid> out_ids, uint32_t max_increment) noexcept;
+
+        /**
+         * Writes uuids created with a random increment, see above, to an output iterator.
+         * @param num_uuids The number of uuids to create.
+         * @param max_increment The largest increment between two uuids.
+         * @param out The output iterator.
+         * @return The output iterator after the last uuid.
+         */
+        template<std::output_iterator<uuid const&> out_it_t>
+        out_it_t create_uuids_random_increment(uint32_t num_uuids, uint32_t max_increment, out_it_t out) noexcept;
+
+        /**
+         * Writes the octets of uuids created with a random increment, see above, to raw memory. No uuid objects are
+         * constructed.
+         * @param num_uuids The number of uuids to create.
+         * @param max_increment The largest increment between two uuids.
+         * @param out The output memory. Must have room for num_uuids * 16 bytes.
+         */
+        void create_uuids_random_increment(uint32_t num_uuids, uint32_t max_increment, void* out) noexcept;
+
+        /**
+         * Returns the random number generator of the factory, e.g. to seed it.
+         */
+        [[nodiscard]] rng_t& get_generator() noexcept { return generator; }
+
+        /**
+         * Returns the clock the factory reads v7 timestamps from.
+         */
+        [[nodiscard]] clock_policy_t& get_clock() noexcept { return clock; }
+
     private:
         rng_t generator;
+        clock_policy_t clock;
+
+        /**
+         * The last tick issued by the monotonic v7 functions and create_uuids_rolling_counter: the millisecond
+         * timestamp followed by the 12 bits of rand_a.
+         */
+        uint64_t last_v7_tick = 0;
+
+        /**
+         * Returns the current time in milliseconds since the Unix epoch.
+         */
+        [[nodiscard]] uint64_t now_ms() noexcept;
 
         static inline constexpr size_t s_version_octet = 6;
         static inline constexpr size_t s_variant_octet = 8;
 
+        /**
+         * The version and variant bits of v4 as masks over the octets: octet = (octet & and_mask) | or_mask.
+         */
+        static inline constexpr uuid::octet_set_t s_v4_and_mask = { 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x0F, 0xFF, 0x3F, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF };
+        static inline constexpr uuid::octet_set_t s_v4_or_mask = { 0, 0, 0, 0, 0, 0, 0x40, 0, 0x80, 0, 0, 0, 0, 0, 0, 0 };
+
+        /**
+         * The generator lanes for the bulk functions, seeded from the factory generator on first use.
+         */
+        xoroshiro128pp_x8 lanes;
+        bool lanes_seeded = false;
+
+        [[nodiscard]] xoroshiro128pp_x8& seeded_lanes() noexcept;
+
+        /**
+         * The random increments are drawn and summed this many at a time.
+         */
+        static inline constexpr size_t s_increment_chunk_size = 512;
+
         void v4_set_version_bits(uuid::octet_set_t &octets) const noexcept;
         void v4_set_variant_bits(uuid::octet_set_t &octets) const noexcept;
 
         void v7_set_ts_ms(uuid::octet_set_t &octets, uint64_t raw_ts) const noexcept;
         void v7_set_rand_a(uuid::octet_set_t &octets, uint16_t value) const noexcept;
         void v7_set_rand_b(uuid::octet_set_t &octets, uint64_t value) const noexcept;
+
+        /**
+         * Sets the timestamp and rand_a from a v7 tick, see detail::to_v7_tick.
+         */
+        void v7_set_tick(uuid::octet_set_t &octets, uint64_t tick) const noexcept;
+
+        /**
+         * Stores a 64-bit value in big endian at octets 0-7 (offset 0) or 8-15 (offset 8).
+         */
+        void v8_set_half(uuid::octet_set_t &octets, size_t offset, uint64_t value) const noexcept;
+
+        /**
+         * Returns the bits of the upper and lower half that are the same for all uuids of a shard and millisecond:
+         * the timestamp, shard id, version and variant.
+         */
+        template<typename layout_t>
+        [[nodiscard]] static std::array<uint64_t, 2> v8_fixed_bits(uint64_t time_ms, uint64_t shard) noexcept;
+
+        /**
+         * The batch functions build each uuid from a prototype with the shared octets already set, and pass it to
+         * emit, which stores all 16 bytes at once.
+         */
+        template<typename emit_t>
+        void dedicated_counter_impl(uint16_t num_uuids, emit_t&& emit) noexcept;
+
+        template<typename emit_t>
+        void rolling_counter_impl(uint32_t num_uuids, std::chrono::milliseconds max_skew, emit_t&& emit) noexcept;
+
+        template<typename emit_t>
+        void monotonic_random_impl(uint32_t num_uuids, uint32_t increment, emit_t&& emit) noexcept;
+
+        template<typename emit_t>
+        void random_increment_impl(uint32_t num_uuids, uint32_t max_increment, emit_t&& emit) noexcept;
+
+        /**
+         * Builds the prototype of a monotonic random batch: one timestamp and rand_a for all uuids. Returns the start
+         * of the 62-bit counter, lowered if needed so that adding up to max_total does not carry into the variant.
+         */
+        uint64_t monotonic_random_prototype(uuid& prototype, uint64_t max_total) noexcept;
     };
 
     // v4
 
-    template <typename rng_t>
-    void uuid_factory<rng_t>::create_uuid_v4(uuid& out_id) noexcept
+    template <typename rng_t, uuid_clock clock_policy_t>
+    void uuid_factory<rng_t, clock_policy_t>::create_uuid_v4(uuid& out_id) noexcept
     {
         uint64_t const n1 = generator();
         uint64_t const n2 = generator();
@@ -84,47 +616,53 @@ namespace LambdaSnail::Uuid
         memcpy(out_id.octets.data(), &n1, sizeof(uint64_t));
         memcpy(out_id.octets.data() + out_id.octets.size()/2, &n2, sizeof(uint64_t));
 
-        out_id.octets[s_version_octet] &= 0b01001111; // Most significant bits set to 0100
-        out_id.octets[s_variant_octet] &= 0b10111111; // Most significant bits set to 10
-
         v4_set_version_bits(out_id.octets);
         v4_set_variant_bits(out_id.octets);
     }
 
-    template <typename rng_t>
-    void uuid_factory<rng_t>::v4_set_version_bits(uuid::octet_set_t& octets) const noexcept
+    template <typename rng_t, uuid_clock clock_policy_t>
+    void uuid_factory<rng_t, clock_policy_t>::create_uuids_v4(std::span<uuid> out_ids) noexcept
     {
-        // Most significant bits in version octet set to 0100
-        uint8_t constexpr b1 = ~(static_cast<uint8_t>(1) << 7);
-        uint8_t constexpr b2 = (static_cast<uint8_t>(1) << 6);
-        uint8_t constexpr b3 = ~(static_cast<uint8_t>(1) << 5);
-        uint8_t constexpr b4 = ~(static_cast<uint8_t>(1) << 4);
+        seeded_lanes().fill(out_ids.data(), out_ids.size(), s_v4_and_mask, s_v4_or_mask);
+    }
 
-        octets[s_version_octet] &= b1;
-        octets[s_version_octet] |= b2;
-        octets[s_version_octet] &= b3;
-        octets[s_version_octet] &= b4;
+    template <typename rng_t, uuid_clock clock_policy_t>
+    xoroshiro128pp_x8& uuid_factory<rng_t, clock_policy_t>::seeded_lanes() noexcept
+    {
+        if (not lanes_seeded)
+        {
+            // Lane 0 starts from the factory generator, and the other lanes are jumps apart from it. The low bit is set
+            // so that the state is never all zero
+            xoroshiro128pp lane_seed;
+            lane_seed.seed_state({ static_cast<uint64_t>(generator()), static_cast<uint64_t>(generator()) | 1 });
+            lanes.seed(lane_seed);
+            lanes_seeded = true;
+        }
+
+        return lanes;
     }
 
-    template <typename rng_t>
-    void uuid_factory<rng_t>::v4_set_variant_bits(uuid::octet_set_t& octets) const noexcept
+    template <typename rng_t, uuid_clock clock_policy_t>
+    void uuid_factory<rng_t, clock_policy_t>::v4_set_version_bits(uuid::octet_set_t& octets) const noexcept
     {
-        // Most significant bits in variant octet set to 10
-        auto constexpr b1 = (static_cast<uint8_t>(1) << 7);
-        auto constexpr b2 = ~(static_cast<uint8_t>(1) << 6);
+        // Most significant bits in version octet set to 0100
+        octets[s_version_octet] = (octets[s_version_octet] & 0b00001111) | 0b01000000;
+    }
 
-        octets[s_variant_octet] |= b1;
-        octets[s_variant_octet] &= b2;
+    template <typename rng_t, uuid_clock clock_policy_t>
+    void uuid_factory<rng_t, clock_policy_t>::v4_set_variant_bits(uuid::octet_set_t& octets) const noexcept
+    {
+        // Most significant bits in variant octet set to 10
+        octets[s_variant_octet] = (octets[s_variant_octet] & 0b00111111) | 0b10000000;
     }
 
     // v7
 
-    template <typename rng_t>
-    void uuid_factory<rng_t>::create_uuid_v7(uuid& out_id) noexcept
+    template <typename rng_t, uuid_clock clock_policy_t>
+    void uuid_factory<rng_t, clock_policy_t>::create_uuid_v7(uuid& out_id) noexcept
     {
         // Set timestampt bits
-        std::chrono::time_point<std::chrono::system_clock> const now = std::chrono::system_clock::now();
-        int64_t const time_stamp = std::chrono::duration_cast<std::chrono::milliseconds>(now.time_since_epoch()).count();
+        uint64_t const time_stamp = now_ms();
 
         v7_set_ts_ms(out_id.octets, time_stamp);
 
@@ -136,58 +674,448 @@ namespace LambdaSnail::Uuid
         v7_set_rand_b(out_id.octets, rand_b);
     }
 
-    template <typename rng_t>
-    void uuid_factory<rng_t>::create_uuids_dedicated_counter(uint16_t num_uuids, std::vector<uuid>& out_vec) noexcept
+    template <typename rng_t, uuid_clock clock_policy_t>
+    void uuid_factory<rng_t, clock_policy_t>::create_uuid_v7_monotonic(uuid& out_id) noexcept
+    {
+        // Guard against the clock standing still or going backwards
+        uint64_t const tick = std::max(detail::to_v7_tick(clock.now()), last_v7_tick + 1);
+        last_v7_tick = tick;
+
+        v7_set_tick(out_id.octets, tick);
+        v7_set_rand_b(out_id.octets, generator());
+    }
+
+    template <typename rng_t, uuid_clock clock_policy_t>
+    void uuid_factory<rng_t, clock_policy_t>::create_uuids_v7_monotonic(std::span<uuid> out_ids) noexcept
     {
-        out_vec.reserve(num_uuids);
+        if (out_ids.empty())
+        {
+            return;
+        }
+
+        uint64_t tick = std::max(detail::to_v7_tick(clock.now()), last_v7_tick + 1);
+        last_v7_tick = tick + out_ids.size() - 1;
+
+        for (uuid& id : out_ids)
+        {
+            v7_set_tick(id.octets, tick++);
+            v7_set_rand_b(id.octets, generator());
+        }
+    }
 
+    template <typename rng_t, uuid_clock clock_policy_t>
+    template <size_t block_size>
+    auto uuid_factory<rng_t, clock_policy_t>::v4_view()
+    {
+        using fill_t = detail::factory_fill<uuid_factory, &uuid_factory::create_uuids_v4>;
+        return uuid_block_view<fill_t, block_size>(fill_t{ this });
+    }
+
+    template <typename rng_t, uuid_clock clock_policy_t>
+    template <size_t block_size>
+    auto uuid_factory<rng_t, clock_policy_t>::v7_view()
+    {
+        using fill_t = detail::factory_fill<uuid_factory, &uuid_factory::create_uuids_v7_monotonic>;
+        return uuid_block_view<fill_t, block_size>(fill_t{ this });
+    }
+
+    template <typename rng_t, uuid_clock clock_policy_t>
+    template <shared_uuid_clock sequencer_clock_t>
+    void uuid_factory<rng_t, clock_policy_t>::create_uuid_v7(v7_sequencer<sequencer_clock_t>& sequencer, uuid& out_id) noexcept
+    {
+        v7_set_tick(out_id.octets, sequencer.claim());
+        v7_set_rand_b(out_id.octets, generator());
+    }
+
+    template <typename rng_t, uuid_clock clock_policy_t>
+    template <shared_uuid_clock sequencer_clock_t>
+    void uuid_factory<rng_t, clock_policy_t>::create_uuids_v7(v7_sequencer<sequencer_clock_t>& sequencer, std::span<uuid> out_ids) noexcept
+    {
+        if (out_ids.empty())
+        {
+            return;
+        }
+
+        uint64_t tick = sequencer.claim(out_ids.size());
+        for (uuid& id : out_ids)
+        {
+            v7_set_tick(id.octets, tick++);
+            v7_set_rand_b(id.octets, generator());
+        }
+    }
+
+    template <typename rng_t, uuid_clock clock_policy_t>
+    template <typename emit_t>
+    void uuid_factory<rng_t, clock_policy_t>::dedicated_counter_impl(uint16_t num_uuids, emit_t&& emit) noexcept
+    {
         // One time stamp for all the uuids
-        std::chrono::time_point<std::chrono::system_clock> const now = std::chrono::system_clock::now();
-        int64_t const time_stamp = std::chrono::duration_cast<std::chrono::milliseconds>(now.time_since_epoch()).count();
+        uuid prototype;
+        v7_set_ts_ms(prototype.octets, now_ms());
 
-        for(int i = 0; i < num_uuids; ++i)
+        for(uint16_t i = 0; i < num_uuids; ++i)
         {
-            uuid& uuid = out_vec.emplace_back(0);
-            v7_set_ts_ms(uuid.octets, time_stamp);
-            v7_set_rand_a(uuid.octets, i);
+            uuid id = prototype;
+            v7_set_rand_a(id.octets, i);
+            v7_set_rand_b(id.octets, generator());
+            emit(id);
+        }
+    }
+
+    template <typename rng_t, uuid_clock clock_policy_t>
+    void uuid_factory<rng_t, clock_policy_t>::create_uuids_dedicated_counter(uint16_t num_uuids, std::vector<uuid>& out_vec) noexcept
+    {
+        out_vec.reserve(out_vec.size() + num_uuids);
+        create_uuids_dedicated_counter(num_uuids, std::back_inserter(out_vec));
+    }
 
-            uint64_t rand_b = generator();
-            v7_set_rand_b(out_vec[i].octets, rand_b);
+    template <typename rng_t, uuid_clock clock_policy_t>
+    void uuid_factory<rng_t, clock_policy_t>::create_uuids_dedicated_counter(std::span<uuid> out_ids) noexcept
+    {
+        create_uuids_dedicated_counter(static_cast<uint16_t>(out_ids.size()), out_ids.begin());
+    }
+
+    template <typename rng_t, uuid_clock clock_policy_t>
+    template <std::output_iterator<uuid const&> out_it_t>
+    out_it_t uuid_factory<rng_t, clock_policy_t>::create_uuids_dedicated_counter(uint16_t num_uuids, out_it_t out) noexcept
+    {
+        dedicated_counter_impl(num_uuids, [&out](uuid const& id) { *out++ = id; });
+        return out;
+    }
+
+    template <typename rng_t, uuid_clock clock_policy_t>
+    void uuid_factory<rng_t, clock_policy_t>::create_uuids_dedicated_counter(uint16_t num_uuids, void* out) noexcept
+    {
+        auto* bytes = static_cast<uint8_t*>(out);
+        dedicated_counter_impl(num_uuids, [&bytes](uuid const& id)
+        {
+            memcpy(bytes, id.octets.data(), sizeof(uuid::octet_set_t));
+            bytes += sizeof(uuid::octet_set_t);
+        });
+    }
+
+    template <typename rng_t, uuid_clock clock_policy_t>
+    template <typename emit_t>
+    void uuid_factory<rng_t, clock_policy_t>::rolling_counter_impl(uint32_t num_uuids, std::chrono::milliseconds max_skew, emit_t&& emit) noexcept
+    {
+        if (num_uuids == 0)
+        {
+            return;
         }
+
+        // A tick is the millisecond timestamp followed by the 12-bit counter, so incrementing it past the last counter
+        // value rolls the timestamp forward. A new millisecond of the clock starts the counter at zero
+        uint64_t constexpr counter_size = static_cast<uint64_t>(1) << detail::s_v7_sub_ms_bits;
+        uint64_t const skew_ms = static_cast<uint64_t>(max_skew.count());
+
+        uint64_t clock_ms = now_ms();
+        uint64_t tick = std::max(clock_ms << detail::s_v7_sub_ms_bits, last_v7_tick + 1);
+
+        // Earlier batches leave the sequence at most one millisecond past the skew. If it is further ahead, the clock
+        // was set backwards (or create_uuid_v7_monotonic ran ahead), and waiting for the clock to catch up could take
+        // hours. Like create_uuid_v7_monotonic, the sequence then keeps running ahead, and the batch only waits for
+        // the skew it creates itself
+        uint64_t const start_ms = tick >> detail::s_v7_sub_ms_bits;
+        uint64_t const lag_ms = start_ms > clock_ms + skew_ms + 1 ? start_ms - clock_ms : 0;
+
+        uint32_t remaining = num_uuids;
+        while (remaining > 0)
+        {
+            // The clock is only read again when the timestamp has run too far ahead of it
+            while ((tick >> detail::s_v7_sub_ms_bits) > clock_ms + lag_ms + skew_ms)
+            {
+                std::this_thread::yield();
+                clock_ms = now_ms();
+                tick = std::max((clock_ms + lag_ms) << detail::s_v7_sub_ms_bits, tick);
+            }
+
+            // The uuids up to the end of this millisecond share the timestamp
+            uuid prototype;
+            v7_set_ts_ms(prototype.octets, tick >> detail::s_v7_sub_ms_bits);
+
+            uint64_t const count = std::min<uint64_t>(remaining, counter_size - (tick & (counter_size - 1)));
+            for (uint64_t i = 0; i < count; ++i, ++tick)
+            {
+                uuid id = prototype;
+                v7_set_rand_a(id.octets, tick & (counter_size - 1));
+                v7_set_rand_b(id.octets, generator());
+                emit(id);
+            }
+
+            remaining -= static_cast<uint32_t>(count);
+        }
+
+        last_v7_tick = tick - 1;
     }
 
-    template <typename rng_t>
-    void uuid_factory<rng_t>::create_uuids_monotonic_random(uint32_t num_uuids, uint32_t increment, std::vector<uuid>& out_vec) noexcept
+    template <typename rng_t, uuid_clock clock_policy_t>
+    void uuid_factory<rng_t, clock_policy_t>::create_uuids_rolling_counter(uint32_t num_uuids, std::vector<uuid>& out_vec, std::chrono::milliseconds max_skew) noexcept
     {
-        out_vec.reserve(num_uuids);
+        out_vec.reserve(out_vec.size() + num_uuids);
+        create_uuids_rolling_counter(num_uuids, std::back_inserter(out_vec), max_skew);
+    }
+
+    template <typename rng_t, uuid_clock clock_policy_t>
+    void uuid_factory<rng_t, clock_policy_t>::create_uuids_rolling_counter(std::span<uuid> out_ids, std::chrono::milliseconds max_skew) noexcept
+    {
+        create_uuids_rolling_counter(static_cast<uint32_t>(out_ids.size()), out_ids.begin(), max_skew);
+    }
+
+    template <typename rng_t, uuid_clock clock_policy_t>
+    template <std::output_iterator<uuid const&> out_it_t>
+    out_it_t uuid_factory<rng_t, clock_policy_t>::create_uuids_rolling_counter(uint32_t num_uuids, out_it_t out, std::chrono::milliseconds max_skew) noexcept
+    {
+        rolling_counter_impl(num_uuids, max_skew, [&out](uuid const& id) { *out++ = id; });
+        return out;
+    }
+
+    template <typename rng_t, uuid_clock clock_policy_t>
+    void uuid_factory<rng_t, clock_policy_t>::create_uuids_rolling_counter(uint32_t num_uuids, void* out, std::chrono::milliseconds max_skew) noexcept
+    {
+        auto* bytes = static_cast<uint8_t*>(out);
+        rolling_counter_impl(num_uuids, max_skew, [&bytes](uuid const& id)
+        {
+            memcpy(bytes, id.octets.data(), sizeof(uuid::octet_set_t));
+            bytes += sizeof(uuid::octet_set_t);
+        });
+    }
 
+    template <typename rng_t, uuid_clock clock_policy_t>
+    uint64_t uuid_factory<rng_t, clock_policy_t>::monotonic_random_prototype(uuid& prototype, uint64_t max_total) noexcept
+    {
         // One time stamp for all the uuids
-        std::chrono::time_point<std::chrono::system_clock> const now = std::chrono::system_clock::now();
-        int64_t const time_stamp = std::chrono::duration_cast<std::chrono::milliseconds>(now.time_since_epoch()).count();
+        v7_set_ts_ms(prototype.octets, now_ms());
 
         // Attempt to create a random 16 bit number by adding the 'four' we get from next()
         uint64_t const rand_a_base = generator();
         uint64_t rand_a = rand_a_base + (rand_a_base >> 16) + (rand_a_base >> 32) + (rand_a_base >> 48);
+        v7_set_rand_a(prototype.octets, rand_a);
+
+        // The counter is the 62 bits of rand_b below the variant bits. Subtract the max_total from base to
+        // guarantee that we can increment as much as we want without carrying into the variant bits
+        uint64_t constexpr counter_mask = (static_cast<uint64_t>(1) << 62) - 1;
+        uint64_t const rand_b_base = generator() & counter_mask;
 
-        uint64_t rand_b_base = generator();
+        return rand_b_base > counter_mask - max_total ? rand_b_base - max_total : rand_b_base;
+    }
 
-        // Subtract the increment_end from base to guarantee that we can increment as much as we want
-        uint64_t const increment_end = static_cast<uint64_t>(num_uuids) * static_cast<uint64_t>(increment);
-        rand_b_base = rand_b_base > increment_end ? rand_b_base - increment_end : rand_b_base;
+    template <typename rng_t, uuid_clock clock_policy_t>
+    template <typename emit_t>
+    void uuid_factory<rng_t, clock_policy_t>::monotonic_random_impl(uint32_t num_uuids, uint32_t increment, emit_t&& emit) noexcept
+    {
+        uuid prototype;
+        uint64_t rand_b_base = monotonic_random_prototype(prototype, static_cast<uint64_t>(num_uuids) * static_cast<uint64_t>(increment));
 
-        for(int i = 0; i < num_uuids; ++i)
+        for(uint32_t i = 0; i < num_uuids; ++i)
         {
-            uuid& uuid = out_vec.emplace_back(0);
-            v7_set_ts_ms(uuid.octets, time_stamp);
-            v7_set_rand_a(uuid.octets, rand_a);
+            uuid id = prototype;
+            v7_set_rand_b(id.octets, rand_b_base);
+            emit(id);
 
-            v7_set_rand_b(out_vec[i].octets, rand_b_base);
             rand_b_base += increment;
         }
     }
 
-    template <typename rng_t>
-    void uuid_factory<rng_t>::v7_set_ts_ms(uuid::octet_set_t& octets, uint64_t raw_ts) const noexcept
+    template <typename rng_t, uuid_clock clock_policy_t>
+    void uuid_factory<rng_t, clock_policy_t>::create_uuids_monotonic_random(uint32_t num_uuids, uint32_t increment, std::vector<uuid>& out_vec) noexcept
+    {
+        out_vec.reserve(out_vec.size() + num_uuids);
+        create_uuids_monotonic_random(num_uuids, increment, std::back_inserter(out_vec));
+    }
+
+    template <typename rng_t, uuid_clock clock_policy_t>
+    void uuid_factory<rng_t, clock_policy_t>::create_uuids_monotonic_random(std::span<uuid> out_ids, uint32_t increment) noexcept
+    {
+        create_uuids_monotonic_random(static_cast<uint32_t>(out_ids.size()), increment, out_ids.begin());
+    }
+
+    template <typename rng_t, uuid_clock clock_policy_t>
+    template <std::output_iterator<uuid const&> out_it_t>
+    out_it_t uuid_factory<rng_t, clock_policy_t>::create_uuids_monotonic_random(uint32_t num_uuids, uint32_t increment, out_it_t out) noexcept
+    {
+        monotonic_random_impl(num_uuids, increment, [&out](uuid const& id) { *out++ = id; });
+        return out;
+    }
+
+    template <typename rng_t, uuid_clock clock_policy_t>
+    void uuid_factory<rng_t, clock_policy_t>::create_uuids_monotonic_random(uint32_t num_uuids, uint32_t increment, void* out) noexcept
+    {
+        auto* bytes = static_cast<uint8_t*>(out);
+        monotonic_random_impl(num_uuids, increment, [&bytes](uuid const& id)
+        {
+            memcpy(bytes, id.octets.data(), sizeof(uuid::octet_set_t));
+            bytes += sizeof(uuid::octet_set_t);
+        });
+    }
+
+    template <typename rng_t, uuid_clock clock_policy_t>
+    template <typename emit_t>
+    void uuid_factory<rng_t, clock_policy_t>::random_increment_impl(uint32_t num_uuids, uint32_t max_increment, emit_t&& emit) noexcept
+    {
+        uuid prototype;
+        uint64_t counter = monotonic_random_prototype(prototype, static_cast<uint64_t>(num_uuids) * static_cast<uint64_t>(max_increment));
+
+        // The increments are drawn and summed a chunk at a time, so the buffers stay in the L1 cache
+        xoroshiro128pp_x8& random_lanes = seeded_lanes();
+        uuid::octet_set_t constexpr all_bits = { 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF };
+        uuid::octet_set_t constexpr no_bits = {};
+
+        alignas(64) std::array<uint32_t, s_increment_chunk_size> random;
+        alignas(64) std::array<uint64_t, s_increment_chunk_size> counters;
+        // Raw octets rather than uuid objects, which would be zeroed on construction
+        alignas(64) std::array<uint8_t, s_increment_chunk_size * sizeof(uuid::octet_set_t)> octets;
+
+        for (uint32_t done = 0; done < num_uuids;)
+        {
+            size_t const count = std::min<size_t>(s_increment_chunk_size, num_uuids - done);
+
+            // Four 32-bit random numbers per 16-byte block
+            random_lanes.fill(random.data(), (count + 3) / 4, all_bits, no_bits);
+            counter = detail::accumulate_increments(random.data(), count, max_increment, counter, counters.data());
+            detail::set_v7_counters(prototype, counters.data(), count, octets.data());
+
+            for (size_t i = 0; i < count; ++i)
+            {
+                uuid id;
+                memcpy(id.octets.data(), octets.data() + i * sizeof(uuid::octet_set_t), sizeof(uuid::octet_set_t));
+                emit(id);
+            }
+
+            done += static_cast<uint32_t>(count);
+        }
+    }
+
+    template <typename rng_t, uuid_clock clock_policy_t>
+    void uuid_factory<rng_t, clock_policy_t>::create_uuids_random_increment(uint32_t num_uuids, uint32_t max_increment, std::vector<uuid>& out_vec) noexcept
+    {
+        out_vec.reserve(out_vec.size() + num_uuids);
+        create_uuids_random_increment(num_uuids, max_increment, std::back_inserter(out_vec));
+    }
+
+    template <typename rng_t, uuid_clock clock_policy_t>
+    void uuid_factory<rng_t, clock_policy_t>::create_uuids_random_increment(std::span<uuid> out_ids, uint32_t max_increment) noexcept
+    {
+        create_uuids_random_increment(static_cast<uint32_t>(out_ids.size()), max_increment, out_ids.begin());
+    }
+
+    template <typename rng_t, uuid_clock clock_policy_t>
+    template <std::output_iterator<uuid const&> out_it_t>
+    out_it_t uuid_factory<rng_t, clock_policy_t>::create_uuids_random_increment(uint32_t num_uuids, uint32_t max_increment, out_it_t out) noexcept
+    {
+        random_increment_impl(num_uuids, max_increment, [&out](uuid const& id) { *out++ = id; });
+        return out;
+    }
+
+    template <typename rng_t, uuid_clock clock_policy_t>
+    void uuid_factory<rng_t, clock_policy_t>::create_uuids_random_increment(uint32_t num_uuids, uint32_t max_increment, void* out) noexcept
+    {
+        auto* bytes = static_cast<uint8_t*>(out);
+        random_increment_impl(num_uuids, max_increment, [&bytes](uuid const& id)
+        {
+            memcpy(bytes, id.octets.data(), sizeof(uuid::octet_set_t));
+            bytes += sizeof(uuid::octet_set_t);
+        });
+    }
+
+    // v8
+
+    template <typename rng_t, uuid_clock clock_policy_t>
+    template <typename layout_t>
+    void uuid_factory<rng_t, clock_policy_t>::create_uuid_v8(uint64_t shard, uuid& out_id) noexcept
+    {
+        std::array<uint64_t, 2> const fixed = v8_fixed_bits<layout_t>(now_ms(), shard);
+
+        v8_set_half(out_id.octets, 0, (generator() & layout_t::s_random_upper) | fixed[0]);
+        v8_set_half(out_id.octets, 8, (generator() & layout_t::s_random_lower) | fixed[1]);
+    }
+
+    template <typename rng_t, uuid_clock clock_policy_t>
+    template <typename layout_t>
+    void uuid_factory<rng_t, clock_policy_t>::create_uuids_v8(uint64_t shard, std::span<uuid> out_ids) noexcept
+    {
+        std::array<uint64_t, 2> const fixed = v8_fixed_bits<layout_t>(now_ms(), shard);
+
+        // The lanes fill each uuid with (random & and_mask) | or_mask, as for v4
+        uuid::octet_set_t and_mask, or_mask;
+        v8_set_half(and_mask, 0, layout_t::s_random_upper);
+        v8_set_half(and_mask, 8, layout_t::s_random_lower);
+        v8_set_half(or_mask, 0, fixed[0]);
+        v8_set_half(or_mask, 8, fixed[1]);
+
+        seeded_lanes().fill(out_ids.data(), out_ids.size(), and_mask, or_mask);
+    }
+
+    template <typename rng_t, uuid_clock clock_policy_t>
+    template <typename layout_t>
+    void uuid_factory<rng_t, clock_policy_t>::create_uuids_v8(uint32_t num_uuids, uint64_t shard, std::vector<uuid>& out_vec) noexcept
+    {
+        size_t const first = out_vec.size();
+        out_vec.resize(first + num_uuids);
+        create_uuids_v8<layout_t>(shard, std::span(out_vec).subspan(first));
+    }
+
+    // Name-based
+
+    template <typename rng_t, uuid_clock clock_policy_t>
+    void uuid_factory<rng_t, clock_policy_t>::create_uuid_v5(uuid const& name_space, std::string_view name, uuid& out_id) const noexcept
+    {
+        detail::create_uuid_v5(name_space, name, out_id);
+    }
+
+    template <typename rng_t, uuid_clock clock_policy_t>
+    void uuid_factory<rng_t, clock_policy_t>::create_uuids_v5(uuid const& name_space, std::span<std::string_view const> names, std::span<uuid> out_ids) const noexcept
+    {
+        detail::create_uuids_v5(name_space, names, out_ids);
+    }
+
+    template <typename rng_t, uuid_clock clock_policy_t>
+    void uuid_factory<rng_t, clock_policy_t>::create_uuid_v3(uuid const& name_space, std::string_view name, uuid& out_id) const noexcept
+    {
+        detail::create_uuid_v3(name_space, name, out_id);
+    }
+
+    template <typename rng_t, uuid_clock clock_policy_t>
+    void uuid_factory<rng_t, clock_policy_t>::create_uuids_v3(uuid const& name_space, std::span<std::string_view const> names, std::span<uuid> out_ids) const noexcept
+    {
+        for (size_t i = 0; i < names.size(); ++i)
+        {
+            detail::create_uuid_v3(name_space, names[i], out_ids[i]);
+        }
+    }
+
+    template <typename rng_t, uuid_clock clock_policy_t>
+    template <typename layout_t>
+    std::array<uint64_t, 2> uuid_factory<rng_t, clock_policy_t>::v8_fixed_bits(uint64_t time_ms, uint64_t shard) noexcept
+    {
+        std::array<uint64_t, 2> fixed = { layout_t::s_version_bits, layout_t::s_variant_bits };
+
+        if constexpr (layout_t::time.width > 0)
+        {
+            fixed[layout_t::time.offset / 64] |= (time_ms & layout_t::value_mask(layout_t::time)) << layout_t::shift(layout_t::time);
+        }
+
+        if constexpr (layout_t::shard_id.width > 0)
+        {
+            fixed[layout_t::shard_id.offset / 64] |= (shard & layout_t::value_mask(layout_t::shard_id)) << layout_t::shift(layout_t::shard_id);
+        }
+
+        return fixed;
+    }
+
+    template <typename rng_t, uuid_clock clock_policy_t>
+    void uuid_factory<rng_t, clock_policy_t>::v7_set_tick(uuid::octet_set_t& octets, uint64_t tick) const noexcept
+    {
+        v7_set_ts_ms(octets, tick >> detail::s_v7_sub_ms_bits);
+        v7_set_rand_a(octets, tick & ((1 << detail::s_v7_sub_ms_bits) - 1));
+    }
+
+    template <typename rng_t, uuid_clock clock_policy_t>
+    uint64_t uuid_factory<rng_t, clock_policy_t>::now_ms() noexcept
+    {
+        return std::chrono::duration_cast<std::chrono::milliseconds>(clock.now()).count();
+    }
+
+    template <typename rng_t, uuid_clock clock_policy_t>
+    void uuid_factory<rng_t, clock_policy_t>::v7_set_ts_ms(uuid::octet_set_t& octets, uint64_t raw_ts) const noexcept
     {
         memcpy(octets.data(), &raw_ts, sizeof(int64_t));
         if constexpr (std::endian::native == std::endian::little)
@@ -198,8 +1126,8 @@ namespace LambdaSnail::Uuid
         }
     }
 
-    template <typename rng_t>
-    void uuid_factory<rng_t>::v7_set_rand_a(uuid::octet_set_t& octets, uint16_t value) const noexcept
+    template <typename rng_t, uuid_clock clock_policy_t>
+    void uuid_factory<rng_t, clock_policy_t>::v7_set_rand_a(uuid::octet_set_t& octets, uint16_t value) const noexcept
     {
         // Most significant bits in version octet set to 0111
         uint16_t constexpr b1 = ~(static_cast<uint16_t>(1) << 15);
@@ -221,8 +1149,8 @@ namespace LambdaSnail::Uuid
         }
     }
 
-    template <typename rng_t>
-    void uuid_factory<rng_t>::v7_set_rand_b(uuid::octet_set_t& octets, uint64_t value) const noexcept
+    template <typename rng_t, uuid_clock clock_policy_t>
+    void uuid_factory<rng_t, clock_policy_t>::v7_set_rand_b(uuid::octet_set_t& octets, uint64_t value) const noexcept
     {
         // Most significant bits set to 10
         uint64_t constexpr b1 = (static_cast<uint64_t>(1) << 63);
@@ -240,4 +1168,17 @@ namespace LambdaSnail::Uuid
             std::swap(octets[11], octets[12]);
         }
     }
+
+    template <typename rng_t, uuid_clock clock_policy_t>
+    void uuid_factory<rng_t, clock_policy_t>::v8_set_half(uuid::octet_set_t& octets, size_t offset, uint64_t value) const noexcept
+    {
+        memcpy(octets.data() + offset, &value, sizeof(uint64_t));
+        if constexpr (std::endian::native == std::endian::little)
+        {
+            std::swap(octets[offset], octets[offset + 7]);
+            std::swap(octets[offset + 1], octets[offset + 6]);
+            std::swap(octets[offset + 2], octets[offset + 5]);
+            std::swap(octets[offset + 3], octets[offset + 4]);
+        }
+    }
 }
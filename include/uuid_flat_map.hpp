@@ -0,0 +1,508 @@
+#pragma once
+
+#include <array>
+#include <bit>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <tuple>
+#include <utility>
+
+#include "uuid.hpp"
+
+namespace LambdaSnail::Uuid
+{
+    namespace detail
+    {
+        /**
+         * Control bytes of the flat hash table. A full slot holds the lower 7 bits of the hash of its key, so the sign
+         * bit alone tells full slots apart from empty and deleted ones.
+         */
+        using ctrl_t = int8_t;
+
+        inline constexpr ctrl_t s_ctrl_empty = -128;
+        inline constexpr ctrl_t s_ctrl_deleted = -2;
+        inline constexpr size_t s_group_size = 16;
+
+        /**
+         * The control bytes of 16 consecutive slots, which are probed together with one SIMD compare.
+         */
+        struct alignas(16) ctrl_group
+        {
+            std::array<ctrl_t, s_group_size> bytes;
+
+            /**
+             * Returns a bit mask of the slots whose control byte equals the value.
+             */
+            [[nodiscard]] uint32_t match(ctrl_t value) const noexcept
+            {
+#ifdef UUID_LIB_USE_SIMD
+                __m128i const ctrl = _mm_load_si128(reinterpret_cast<__m128i const*>(bytes.data()));
+                return static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(ctrl, _mm_set1_epi8(value))));
+#else
+                uint32_t mask = 0;
+                for (size_t i = 0; i < s_group_size; ++i)
+                {
+                    mask |= static_cast<uint32_t>(bytes[i] == value) << i;
+                }
+
+                return mask;
+#endif
+            }
+
+            /**
+             * Returns a bit mask of the slots that are empty or deleted.
+             */
+            [[nodiscard]] uint32_t match_free() const noexcept
+            {
+#ifdef UUID_LIB_USE_SIMD
+                return static_cast<uint32_t>(_mm_movemask_epi8(_mm_load_si128(reinterpret_cast<__m128i const*>(bytes.data()))));
+#else
+                uint32_t mask = 0;
+                for (size_t i = 0; i < s_group_size; ++i)
+                {
+                    mask |= static_cast<uint32_t>(bytes[i] < 0) << i;
+                }
+
+                return mask;
+#endif
+            }
+        };
+
+        /**
+         * Open-addressing hash table keyed on uuid, in the style of a Swiss table. Slots are grouped 16 at a time,
+         * and a lookup compares the 7-bit hash fragment of the key against a whole group of control bytes at once,
+         * so that only slots with a matching fragment have their uuid compared. Groups are probed triangularly.
+         *
+         * The values are stored inline in one array, so a lookup touches one control group and usually one slot.
+         *
+         * @tparam value_t The value type, either uuid itself or a pair whose first member is the uuid key.
+         */
+        template<typename value_t>
+        class uuid_flat_table
+        {
+            static constexpr bool s_is_set = std::is_same_v<value_t, uuid>;
+
+        public:
+            using key_type = uuid;
+            using value_type = value_t;
+            using size_type = size_t;
+            using hasher = std::hash<uuid>;
+
+            template<bool is_const>
+            class iterator_base
+            {
+                using table_t = std::conditional_t<is_const, uuid_flat_table const, uuid_flat_table>;
+
+            public:
+                using iterator_category = std::forward_iterator_tag;
+                using value_type = value_t;
+                using difference_type = ptrdiff_t;
+                using pointer = std::conditional_t<is_const, value_t const*, value_t*>;
+                using reference = std::conditional_t<is_const, value_t const&, value_t&>;
+
+                iterator_base() = default;
+                iterator_base(table_t* table, size_t index) : m_table(table), m_index(index) {}
+
+                // A non-const iterator converts to a const one
+                operator iterator_base<true>() const { return { m_table, m_index }; }
+
+                reference operator*() const { return m_table->m_slots[m_index]; }
+                pointer operator->() const { return m_table->m_slots + m_index; }
+
+                iterator_base& operator++()
+                {
+                    m_index = m_table->next_full(m_index + 1);
+                    return *this;
+                }
+
+                iterator_base operator++(int)
+                {
+                    iterator_base copy = *this;
+                    ++*this;
+                    return copy;
+                }
+
+                bool operator==(iterator_base const& other) const { return m_index == other.m_index; }
+
+            private:
+                table_t* m_table = nullptr;
+                size_t m_index = 0;
+            };
+
+            // Elements of a set must not be modified in place, since that would change their hash
+            using iterator = std::conditional_t<s_is_set, iterator_base<true>, iterator_base<false>>;
+            using const_iterator = iterator_base<true>;
+
+            uuid_flat_table() = default;
+
+            uuid_flat_table(uuid_flat_table const& other)
+            {
+                reserve(other.size());
+                for (value_t const& value : other)
+                {
+                    emplace_unique(key_of(value), value);
+                }
+            }
+
+            uuid_flat_table(uuid_flat_table&& other) noexcept
+            {
+                swap(other);
+            }
+
+            uuid_flat_table& operator=(uuid_flat_table other) noexcept
+            {
+                swap(other);
+                return *this;
+            }
+
+            ~uuid_flat_table()
+            {
+                destroy_slots();
+                deallocate();
+            }
+
+            void swap(uuid_flat_table& other) noexcept
+            {
+                std::swap(m_ctrl, other.m_ctrl);
+                std::swap(m_slots, other.m_slots);
+                std::swap(m_num_groups, other.m_num_groups);
+                std::swap(m_size, other.m_size);
+                std::swap(m_growth_left, other.m_growth_left);
+            }
+
+            [[nodiscard]] size_t size() const noexcept { return m_size; }
+            [[nodiscard]] bool empty() const noexcept { return m_size == 0; }
+            [[nodiscard]] size_t capacity() const noexcept { return m_num_groups * s_group_size; }
+
+            iterator begin() noexcept { return { this, next_full(0) }; }
+            iterator end() noexcept { return { this, capacity() }; }
+            const_iterator begin() const noexcept { return { this, next_full(0) }; }
+            const_iterator end() const noexcept { return { this, capacity() }; }
+
+            /**
+             * Makes room for at least the given number of elements without further rehashing.
+             */
+            void reserve(size_t num_elements)
+            {
+                size_t const num_groups = std::bit_ceil(num_elements * 8 / 7 / s_group_size + 1);
+                if (num_groups > m_num_groups)
+                {
+                    rehash(num_groups);
+                }
+            }
+
+            /**
+             * Removes all elements, but keeps the allocated memory.
+             */
+            void clear() noexcept
+            {
+                destroy_slots();
+                for (size_t g = 0; g < m_num_groups; ++g)
+                {
+                    m_ctrl[g].bytes.fill(s_ctrl_empty);
+                }
+
+                m_size = 0;
+                m_growth_left = max_load(m_num_groups);
+            }
+
+            iterator find(uuid const& key) noexcept
+            {
+                size_t const index = find_index(key, hasher{}(key));
+                return { this, index == npos ? capacity() : index };
+            }
+
+            const_iterator find(uuid const& key) const noexcept
+            {
+                size_t const index = find_index(key, hasher{}(key));
+                return { this, index == npos ? capacity() : index };
+            }
+
+            [[nodiscard]] bool contains(uuid const& key) const noexcept
+            {
+                return find_index(key, hasher{}(key)) != npos;
+            }
+
+            [[nodiscard]] size_t count(uuid const& key) const noexcept
+            {
+                return contains(key) ? 1 : 0;
+            }
+
+            /**
+             * Removes the element with the given key, if any.
+             * @return The number of elements removed.
+             */
+            size_t erase(uuid const& key) noexcept
+            {
+                size_t const index = find_index(key, hasher{}(key));
+                if (index == npos)
+                {
+                    return 0;
+                }
+
+                std::destroy_at(m_slots + index);
+                --m_size;
+
+                // If the group still has an empty slot, no probe sequence has ever continued past it, so the slot
+                // can be marked empty rather than leaving a tombstone
+                ctrl_group& group = m_ctrl[index / s_group_size];
+                if (group.match(s_ctrl_empty) != 0)
+                {
+                    group.bytes[index % s_group_size] = s_ctrl_empty;
+                    ++m_growth_left;
+                }
+                else
+                {
+                    group.bytes[index % s_group_size] = s_ctrl_deleted;
+                }
+
+                return 1;
+            }
+
+        protected:
+            /**
+             * Inserts a value constructed from the arguments, unless the key is already present.
+             */
+            template<typename... args_t>
+            std::pair<iterator, bool> try_emplace_impl(uuid const& key, args_t&&... args)
+            {
+                size_t const hash = hasher{}(key);
+                if (size_t const index = find_index(key, hash); index != npos)
+                {
+                    return { iterator(this, index), false };
+                }
+
+                if (m_growth_left == 0)
+                {
+                    rehash(m_num_groups == 0 ? 1 : (m_size >= max_load(m_num_groups) / 2 ? m_num_groups * 2 : m_num_groups));
+                }
+
+                size_t const index = find_free(hash);
+                if (m_ctrl[index / s_group_size].bytes[index % s_group_size] == s_ctrl_empty)
+                {
+                    --m_growth_left;
+                }
+
+                std::construct_at(m_slots + index, std::forward<args_t>(args)...);
+                m_ctrl[index / s_group_size].bytes[index % s_group_size] = h2(hash);
+                ++m_size;
+
+                return { iterator(this, index), true };
+            }
+
+        private:
+            static constexpr size_t npos = ~static_cast<size_t>(0);
+
+            std::unique_ptr<ctrl_group[]> m_ctrl;
+            value_t* m_slots = nullptr;
+            size_t m_num_groups = 0;
+            size_t m_size = 0;
+            size_t m_growth_left = 0;
+
+            static uuid const& key_of(value_t const& value) noexcept
+            {
+                if constexpr (s_is_set)
+                {
+                    return value;
+                }
+                else
+                {
+                    return value.first;
+                }
+            }
+
+            static constexpr size_t max_load(size_t num_groups) noexcept
+            {
+                return num_groups * s_group_size * 7 / 8;
+            }
+
+            static ctrl_t h2(size_t hash) noexcept
+            {
+                return static_cast<ctrl_t>(hash & 0x7F);
+            }
+
+            [[nodiscard]] size_t find_index(uuid const& key, size_t hash) const noexcept
+            {
+                if (m_num_groups == 0)
+                {
+                    return npos;
+                }
+
+                size_t const group_mask = m_num_groups - 1;
+                size_t group = (hash >> 7) & group_mask;
+
+                for (size_t step = 1; ; ++step)
+                {
+                    ctrl_group const& ctrl = m_ctrl[group];
+                    for (uint32_t match = ctrl.match(h2(hash)); match != 0; match &= match - 1)
+                    {
+                        size_t const index = group * s_group_size + std::countr_zero(match);
+                        if (key_of(m_slots[index]) == key)
+                        {
+                            return index;
+                        }
+                    }
+
+                    if (ctrl.match(s_ctrl_empty) != 0)
+                    {
+                        return npos;
+                    }
+
+                    group = (group + step) & group_mask;
+                }
+            }
+
+            [[nodiscard]] size_t find_free(size_t hash) const noexcept
+            {
+                size_t const group_mask = m_num_groups - 1;
+                size_t group = (hash >> 7) & group_mask;
+
+                for (size_t step = 1; ; ++step)
+                {
+                    if (uint32_t const free = m_ctrl[group].match_free(); free != 0)
+                    {
+                        return group * s_group_size + std::countr_zero(free);
+                    }
+
+                    group = (group + step) & group_mask;
+                }
+            }
+
+            [[nodiscard]] size_t next_full(size_t index) const noexcept
+            {
+                while (index < capacity() and m_ctrl[index / s_group_size].bytes[index % s_group_size] < 0)
+                {
+                    ++index;
+                }
+
+                return index;
+            }
+
+            /**
+             * Inserts a value known not to be in the table, which must have room for it.
+             */
+            void emplace_unique(uuid const& key, value_t const& value)
+            {
+                size_t const hash = hasher{}(key);
+                size_t const index = find_free(hash);
+
+                std::construct_at(m_slots + index, value);
+                m_ctrl[index / s_group_size].bytes[index % s_group_size] = h2(hash);
+                ++m_size;
+                --m_growth_left;
+            }
+
+            void rehash(size_t num_groups)
+            {
+                // Both arrays are allocated before the table is touched, so that it is left as it was if either throws
+                std::unique_ptr<ctrl_group[]> new_ctrl = std::make_unique<ctrl_group[]>(num_groups);
+                for (size_t g = 0; g < num_groups; ++g)
+                {
+                    new_ctrl[g].bytes.fill(s_ctrl_empty);
+                }
+
+                value_t* const new_slots = std::allocator<value_t>().allocate(num_groups * s_group_size);
+
+                std::unique_ptr<ctrl_group[]> old_ctrl = std::exchange(m_ctrl, std::move(new_ctrl));
+                value_t* const old_slots = std::exchange(m_slots, new_slots);
+                size_t const old_num_groups = m_num_groups;
+
+                m_num_groups = num_groups;
+                m_growth_left = max_load(num_groups) - m_size;
+
+                for (size_t i = 0; i < old_num_groups * s_group_size; ++i)
+                {
+                    if (old_ctrl[i / s_group_size].bytes[i % s_group_size] >= 0)
+                    {
+                        size_t const hash = hasher{}(key_of(old_slots[i]));
+                        size_t const index = find_free(hash);
+
+                        std::construct_at(m_slots + index, std::move(old_slots[i]));
+                        std::destroy_at(old_slots + i);
+                        m_ctrl[index / s_group_size].bytes[index % s_group_size] = h2(hash);
+                    }
+                }
+
+                if (old_slots != nullptr)
+                {
+                    std::allocator<value_t>().deallocate(old_slots, old_num_groups * s_group_size);
+                }
+            }
+
+            void destroy_slots() noexcept
+            {
+                if constexpr (not std::is_trivially_destructible_v<value_t>)
+                {
+                    for (size_t i = next_full(0); i < capacity(); i = next_full(i + 1))
+                    {
+                        std::destroy_at(m_slots + i);
+                    }
+                }
+            }
+
+            void deallocate() noexcept
+            {
+                if (m_slots != nullptr)
+                {
+                    std::allocator<value_t>().deallocate(m_slots, capacity());
+                    m_slots = nullptr;
+                }
+            }
+        };
+    }
+
+    /**
+     * A hash map keyed on uuid that stores its elements inline in one flat array, instead of one heap node per element
+     * like std::unordered_map. Lookups probe 16 slots at a time with SIMD. Iterators and references are invalidated
+     * by any insertion that grows the table.
+     *
+     * @tparam T The mapped type.
+     */
+    template<typename T>
+    class uuid_flat_map : public detail::uuid_flat_table<std::pair<uuid const, T>>
+    {
+        using base_t = detail::uuid_flat_table<std::pair<uuid const, T>>;
+
+    public:
+        using mapped_type = T;
+        using typename base_t::iterator;
+        using typename base_t::value_type;
+
+        /**
+         * Inserts a value constructed from the arguments if the key is not already present.
+         * @return An iterator to the element with the key, and whether an insertion took place.
+         */
+        template<typename... args_t>
+        std::pair<iterator, bool> try_emplace(uuid const& key, args_t&&... args)
+        {
+            return this->try_emplace_impl(key, std::piecewise_construct, std::forward_as_tuple(key), std::forward_as_tuple(std::forward<args_t>(args)...));
+        }
+
+        std::pair<iterator, bool> insert(value_type const& value)
+        {
+            return this->try_emplace_impl(value.first, value);
+        }
+
+        /**
+         * Returns the value for the key, inserting a default constructed value if the key is not present.
+         */
+        T& operator[](uuid const& key)
+        {
+            return try_emplace(key).first->second;
+        }
+    };
+
+    /**
+     * A hash set of uuids that stores its elements inline in one flat array. Lookups probe 16 slots at a time with SIMD.
+     * Iterators are invalidated by any insertion that grows the table.
+     */
+    class uuid_flat_set : public detail::uuid_flat_table<uuid>
+    {
+    public:
+        std::pair<iterator, bool> insert(uuid const& id)
+        {
+            return try_emplace_impl(id, id);
+        }
+    };
+}
@@ -2,74 +2,94 @@
 
 #include <algorithm>
 #include <format>
-#include <iostream>
-#include <sstream>
+#include <string_view>
 
 #include "uuid.hpp"
 
+/**
+ * Formats a uuid with std::format. The format spec is made up of the following flags, which can be combined in any order:
+ *
+ * - '#' encloses the uuid in curly braces
+ * - 'u' uses upper case hex digits
+ * - 'n' leaves out the dashes
+ * - 'r' adds the "urn:uuid:" prefix from the URN namespace in the RFC
+ *
+ * For example, std::format("{:#u}", id) gives an upper case uuid in braces.
+ */
 template<>
 struct std::formatter<LambdaSnail::Uuid::uuid> {
     bool m_IsBraced = false;
     bool m_IsUpperCase = false;
+    bool m_IsNoDash = false;
+    bool m_IsUrn = false;
+
+    static constexpr std::string_view s_UrnPrefix = "urn:uuid:";
 
     template<class ParseContext>
     constexpr typename ParseContext::iterator parse(ParseContext &ctx)
     {
         auto it = ctx.begin();
-        if (it == ctx.end())
-            return it;
-
-        if (*it == '#')
-        {
-            m_IsBraced = true;
-            ++it;
-        }
-
-        if (*it == 'u')
+        for (; it != ctx.end() && *it != '}'; ++it)
         {
-            m_IsUpperCase = true;
-            ++it;
+            switch (*it)
+            {
+                case '#':
+                    m_IsBraced = true;
+                    break;
+                case 'u':
+                    m_IsUpperCase = true;
+                    break;
+                case 'n':
+                    m_IsNoDash = true;
+                    break;
+                case 'r':
+                    m_IsUrn = true;
+                    break;
+                default:
+                    throw std::format_error("Invalid format for uuid.");
+            }
         }
 
-        if (it != ctx.end() && *it != '}')
-            throw std::format_error("Invalid format for uuid.");
-
         return it;
     }
 
     template<class FmtContext>
     typename FmtContext::iterator format(LambdaSnail::Uuid::uuid const &id, FmtContext &ctx) const
     {
-        std::ostringstream out;
-        if (m_IsBraced)
-        {
-            out << '{';
-        }
+        using LambdaSnail::Uuid::string_conversion_mode;
 
-        ios::fmtflags const flags(out.flags());
+        // Format into a small buffer on the stack, then hand the whole thing to the output in one write
+        char buffer[s_UrnPrefix.size() + LambdaSnail::Uuid::string_length<string_conversion_mode::curly_braces>];
+        char* out = buffer;
 
-        for (int i = 0; i < id.octets.size(); ++i)
+        if (m_IsUrn)
         {
-            if(m_IsUpperCase)
-            {
-                out << std::uppercase;
-            }
-
-            out << std::setw(2) << std::setfill('0') << std::hex << static_cast<int32_t>(id.octets[i]);
+            out = std::ranges::copy(s_UrnPrefix, out).out;
+        }
 
-            if (i == 3 or i == 5 or i == 7 or i == 9)
-            {
-                out << '-';
-            }
+        if (m_IsBraced)
+        {
+            *out++ = '{';
         }
 
-        out.flags(flags);
+        if (m_IsNoDash)
+        {
+            LambdaSnail::Uuid::detail::format_octets<string_conversion_mode::no_dash>(id.octets.data(), out, m_IsUpperCase);
+            out += LambdaSnail::Uuid::string_length<string_conversion_mode::no_dash>;
+        }
+        else
+        {
+            LambdaSnail::Uuid::detail::format_octets<string_conversion_mode::standard>(id.octets.data(), out, m_IsUpperCase);
+            out += LambdaSnail::Uuid::string_length<string_conversion_mode::standard>;
+        }
 
         if (m_IsBraced)
         {
-            out << '}';
+            *out++ = '}';
         }
 
-        return std::ranges::copy(std::move(out).str(), ctx.out()).out;
+        // The string_view formatter writes to the contiguous buffer of the format context in bulk, where the
+        // implementation provides one
+        return std::formatter<std::string_view>().format(std::string_view(buffer, out), ctx);
     }
 };
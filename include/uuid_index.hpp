@@ -0,0 +1,546 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <ostream>
+#include <span>
+#include <system_error>
+#include <type_traits>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <cerrno>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include "uuid.hpp"
+
+namespace LambdaSnail::Uuid
+{
+    /**
+     * Writes an index file for a sorted set of uuids, to be opened with uuid_index_file. The file holds a header, a
+     * bucket table and the uuids themselves, so building the index at startup is replaced by mapping the file.
+     * @param sorted_ids The uuids, in ascending order (as sorted by uuid_sort). Duplicates are allowed.
+     * @param out The stream to write to, which should be opened in binary mode.
+     * @return A value initialized std::errc on success, std::errc::invalid_argument if the uuids are not sorted and
+     * std::errc::io_error if writing fails.
+     */
+    [[nodiscard]] std::errc write_uuid_index(std::span<uuid const> sorted_ids, std::ostream& out);
+
+    /**
+     * Writes an index file for a sorted set of uuids to a path, replacing any existing file.
+     */
+    [[nodiscard]] std::errc write_uuid_index(std::span<uuid const> sorted_ids, std::filesystem::path const& path);
+
+    namespace detail
+    {
+        inline constexpr std::array<char, 8> s_index_magic = { 'L', 'S', 'U', 'U', 'I', 'D', 'X', '1' };
+        inline constexpr uint32_t s_index_version = 1;
+        inline constexpr uint32_t s_index_byte_order = 0x01020304;
+
+        /**
+         * The average number of uuids per bucket the writer aims for. Four uuids take one cache line.
+         */
+        inline constexpr uint64_t s_index_uuids_per_bucket = 4;
+
+        /**
+         * The needles that batched lookups have in flight at a time.
+         */
+        inline constexpr size_t s_index_batch_size = 16;
+
+        /**
+         * The start of the index file. All integers are in the byte order of the machine that wrote the file, which
+         * is checked when the file is opened.
+         */
+        struct index_header
+        {
+            std::array<char, 8> magic;
+            uint32_t version;
+            uint32_t byte_order;
+            uint64_t num_uuids;
+            uint64_t num_buckets;
+            uint64_t shift;
+            uint64_t min_hi;
+            uint64_t min_lo;
+            uint64_t buckets_offset;
+            uint64_t uuids_offset;
+        };
+
+        static_assert(sizeof(index_header) == 72 and std::is_trivially_copyable_v<index_header>);
+
+        /**
+         * A uuid as a 128-bit integer, in two halves, so that integer comparison matches the octet order.
+         */
+        struct index_key
+        {
+            uint64_t hi;
+            uint64_t lo;
+        };
+
+        inline index_key to_index_key(uuid const& id) noexcept
+        {
+            return { load_big_endian(id.octets.data()), load_big_endian(id.octets.data() + 8) };
+        }
+
+        inline bool key_less(index_key const& a, index_key const& b) noexcept
+        {
+            return a.hi < b.hi or (a.hi == b.hi and a.lo < b.lo);
+        }
+
+        /**
+         * Returns the bucket of a key: its difference to the smallest key, shifted right. The caller makes sure that
+         * the key is not smaller than min and that the result fits into 64 bits.
+         */
+        inline uint64_t bucket_of(index_key const& key, index_key const& min, uint64_t shift) noexcept
+        {
+            uint64_t const lo = key.lo - min.lo;
+            uint64_t const hi = key.hi - min.hi - (key.lo < min.lo ? 1 : 0);
+
+            if (shift >= 64)
+            {
+                return hi >> (shift - 64);
+            }
+
+            return shift == 0 ? lo : (lo >> shift) | (hi << (64 - shift));
+        }
+
+        inline constexpr uint64_t align_index_offset(uint64_t offset) noexcept
+        {
+            return (offset + 63) & ~static_cast<uint64_t>(63);
+        }
+
+        inline void prefetch(void const* address) noexcept
+        {
+#if defined(__GNUC__) || defined(__clang__)
+            __builtin_prefetch(address);
+#elif defined(UUID_LIB_USE_SIMD)
+            _mm_prefetch(static_cast<char const*>(address), _MM_HINT_T0);
+#endif
+        }
+    }
+
+    /**
+     * A read-only view of an index written by write_uuid_index, in memory owned by someone else (usually a
+     * uuid_index_file). Nothing is parsed or copied: lookups read the bucket table and the uuids where they are.
+     *
+     * The bucket table is an interpolation model of the sorted uuids. Each uuid is taken as a 128-bit integer and its
+     * difference to the smallest uuid is shifted right, so that the buckets evenly divide the range of the set, about
+     * four uuids per bucket. For version 7 uuids that is the timestamp, followed by the random bits within a
+     * millisecond. The table holds the position of the first uuid of each bucket, so a lookup reads one table entry
+     * and then searches the few uuids of its bucket: about two cache misses for a set that does not fit in the cache.
+     * Sets that are very unevenly spread over their range (for example a day of uuids with one large batch from the
+     * same millisecond) have larger buckets, which are binary searched.
+     */
+    class uuid_index_view
+    {
+    public:
+        uuid_index_view() = default;
+
+        /**
+         * Creates a view of an index in memory. Only the header is checked, the uuids and the bucket table are not
+         * read.
+         * @param bytes The index, as written by write_uuid_index. Must be aligned to 16 bytes.
+         * @param out_view The view, if the header is valid.
+         * @return A value initialized std::errc on success, otherwise std::errc::invalid_argument.
+         */
+        [[nodiscard]] static std::errc from_bytes(std::span<std::byte const> bytes, uuid_index_view& out_view) noexcept
+        {
+            detail::index_header header;
+            if (bytes.size() < sizeof(header) or reinterpret_cast<uintptr_t>(bytes.data()) % alignof(uuid) != 0)
+            {
+                return std::errc::invalid_argument;
+            }
+
+            memcpy(&header, bytes.data(), sizeof(header));
+
+            uint64_t const size = bytes.size();
+            bool const valid = header.magic == detail::s_index_magic and header.version == detail::s_index_version
+                and header.byte_order == detail::s_index_byte_order and header.shift < 128
+                and header.num_buckets > 0 and header.num_buckets < size / sizeof(uint64_t)
+                and header.num_uuids <= size / sizeof(uuid)
+                and header.buckets_offset % 64 == 0 and header.buckets_offset >= sizeof(header)
+                and header.buckets_offset <= size - (header.num_buckets + 1) * sizeof(uint64_t)
+                and header.uuids_offset % 64 == 0 and header.uuids_offset >= header.buckets_offset + (header.num_buckets + 1) * sizeof(uint64_t)
+                and header.uuids_offset <= size - header.num_uuids * sizeof(uuid);
+            if (not valid)
+            {
+                return std::errc::invalid_argument;
+            }
+
+            uuid_index_view view;
+            view.m_buckets = reinterpret_cast<uint64_t const*>(bytes.data() + header.buckets_offset);
+            view.m_ids = reinterpret_cast<uuid const*>(bytes.data() + header.uuids_offset);
+            view.m_size = header.num_uuids;
+            view.m_num_buckets = header.num_buckets;
+            view.m_shift = header.shift;
+            view.m_min = { header.min_hi, header.min_lo };
+            view.m_max = view.m_size == 0 ? view.m_min : detail::to_index_key(view.m_ids[view.m_size - 1]);
+
+            if (view.m_buckets[view.m_num_buckets] != view.m_size)
+            {
+                return std::errc::invalid_argument;
+            }
+
+            // The model must match the uuids, or lookups would compute buckets past the end of the table
+            if (view.m_size > 0)
+            {
+                detail::index_key const first = detail::to_index_key(view.m_ids[0]);
+                uint64_t const range_hi = view.m_max.hi - view.m_min.hi - (view.m_max.lo < view.m_min.lo ? 1 : 0);
+                bool const fits = view.m_shift >= 64 or (range_hi >> view.m_shift) == 0;
+                if (first.hi != view.m_min.hi or first.lo != view.m_min.lo or detail::key_less(view.m_max, view.m_min)
+                    or not fits or detail::bucket_of(view.m_max, view.m_min, view.m_shift) >= view.m_num_buckets)
+                {
+                    return std::errc::invalid_argument;
+                }
+            }
+
+            out_view = view;
+            return {};
+        }
+
+        [[nodiscard]] size_t size() const noexcept { return m_size; }
+        [[nodiscard]] bool empty() const noexcept { return m_size == 0; }
+
+        /**
+         * Returns the uuids of the index in ascending order.
+         */
+        [[nodiscard]] std::span<uuid const> ids() const noexcept { return { m_ids, m_size }; }
+
+        /**
+         * Returns the position of the needle in ids(), or size() if the index does not hold it. With duplicates, the
+         * position of the first is returned.
+         */
+        [[nodiscard]] size_t find(uuid const& needle) const noexcept
+        {
+            detail::index_key const key = detail::to_index_key(needle);
+            if (not in_range(key))
+            {
+                return m_size;
+            }
+
+            uint64_t const bucket = detail::bucket_of(key, m_min, m_shift);
+            return search(key, m_buckets[bucket], m_buckets[bucket + 1]);
+        }
+
+        /**
+         * Looks up several needles. The lookups are interleaved, so that the cache misses of up to 16 needles
+         * overlap instead of being waited for one after the other.
+         * @param needles The uuids to look for.
+         * @param out_indices The output positions, as returned by find. Must be at least as large as needles.
+         */
+        void find(std::span<uuid const> needles, std::span<size_t> out_indices) const noexcept
+        {
+            std::array<detail::index_key, detail::s_index_batch_size> keys;
+            std::array<uint64_t, detail::s_index_batch_size> buckets;
+            std::array<uint64_t, detail::s_index_batch_size> firsts;
+
+            // An empty index, or one that is not open, has no bucket table to read
+            if (m_size == 0 or m_buckets == nullptr)
+            {
+                std::fill_n(out_indices.begin(), needles.size(), m_size);
+                return;
+            }
+
+            for (size_t start = 0; start < needles.size(); start += detail::s_index_batch_size)
+            {
+                size_t const count = std::min(detail::s_index_batch_size, needles.size() - start);
+
+                // Find the buckets and fetch their table entries, then fetch the first uuid of each bucket
+                for (size_t i = 0; i < count; ++i)
+                {
+                    keys[i] = detail::to_index_key(needles[start + i]);
+                    buckets[i] = in_range(keys[i]) ? detail::bucket_of(keys[i], m_min, m_shift) : m_num_buckets;
+                    detail::prefetch(m_buckets + buckets[i]);
+                }
+
+                for (size_t i = 0; i < count; ++i)
+                {
+                    firsts[i] = m_buckets[buckets[i]];
+                    detail::prefetch(m_ids + std::min<uint64_t>(firsts[i], m_size - (m_size > 0 ? 1 : 0)));
+                }
+
+                for (size_t i = 0; i < count; ++i)
+                {
+                    out_indices[start + i] = buckets[i] == m_num_buckets ? m_size : search(keys[i], firsts[i], m_buckets[buckets[i] + 1]);
+                }
+            }
+        }
+
+        /**
+         * Returns true if the index holds the needle.
+         */
+        [[nodiscard]] bool contains(uuid const& needle) const noexcept
+        {
+            return find(needle) != m_size;
+        }
+
+    private:
+        uuid const* m_ids = nullptr;
+        uint64_t const* m_buckets = nullptr;
+        size_t m_size = 0;
+        uint64_t m_num_buckets = 0;
+        uint64_t m_shift = 0;
+        detail::index_key m_min{};
+        detail::index_key m_max{};
+
+        [[nodiscard]] bool in_range(detail::index_key const& key) const noexcept
+        {
+            return m_size > 0 and not detail::key_less(key, m_min) and not detail::key_less(m_max, key);
+        }
+
+        /**
+         * Branch-free lower bound of the key in the uuids at positions first to last - 1.
+         */
+        [[nodiscard]] size_t search(detail::index_key const& key, uint64_t first, uint64_t last) const noexcept
+        {
+            // Only the header is checked when the view is created, so a corrupt table must not lead outside the uuids
+            last = std::min<uint64_t>(last, m_size);
+            first = std::min(first, last);
+            if (first == last)
+            {
+                return m_size;
+            }
+
+            uuid const* base = m_ids + first;
+            for (uint64_t length = last - first; length > 1; length -= length / 2)
+            {
+                base = detail::key_less(detail::to_index_key(base[length / 2 - 1]), key) ? base + length / 2 : base;
+            }
+
+            detail::index_key const found = detail::to_index_key(*base);
+            return found.hi == key.hi and found.lo == key.lo ? static_cast<size_t>(base - m_ids) : m_size;
+        }
+    };
+
+    /**
+     * An index file written by write_uuid_index, mapped into memory read-only. Opening the file maps it and checks
+     * its header, and does not read anything else, so it takes the same time for a thousand uuids as for a billion.
+     * Pages of the file are loaded by the operating system when lookups touch them, and are shared between processes
+     * that map the same file.
+     *
+     * The file must not be changed while it is mapped. To replace the index (e.g. a nightly rebuild), write a new
+     * file and rename it over the old one; open mappings keep the old contents.
+     */
+    class uuid_index_file
+    {
+    public:
+        uuid_index_file() = default;
+
+        uuid_index_file(uuid_index_file const&) = delete;
+        uuid_index_file& operator=(uuid_index_file const&) = delete;
+
+        uuid_index_file(uuid_index_file&& other) noexcept { swap(other); }
+
+        uuid_index_file& operator=(uuid_index_file&& other) noexcept
+        {
+            uuid_index_file moved(std::move(other));
+            swap(moved);
+            return *this;
+        }
+
+        ~uuid_index_file() { close(); }
+
+        /**
+         * Maps an index file, closing the one that was open before.
+         * @return A value initialized std::errc on success, the error of the operating system if the file cannot be
+         * opened or mapped, and std::errc::invalid_argument if it is not a valid index file.
+         */
+        [[nodiscard]] std::errc open(std::filesystem::path const& path) noexcept
+        {
+            close();
+
+            std::errc const ec = map(path);
+            if (ec != std::errc{})
+            {
+                return ec;
+            }
+
+            std::errc const view_ec = uuid_index_view::from_bytes({ static_cast<std::byte const*>(m_data), m_length }, m_view);
+            if (view_ec != std::errc{})
+            {
+                close();
+            }
+
+            return view_ec;
+        }
+
+        void close() noexcept
+        {
+            if (m_data != nullptr)
+            {
+#ifdef _WIN32
+                UnmapViewOfFile(m_data);
+#else
+                munmap(m_data, m_length);
+#endif
+            }
+
+            m_data = nullptr;
+            m_length = 0;
+            m_view = {};
+        }
+
+        [[nodiscard]] bool is_open() const noexcept { return m_data != nullptr; }
+
+        /**
+         * Returns the view for lookups. An index that is not open is empty.
+         */
+        [[nodiscard]] uuid_index_view const& view() const noexcept { return m_view; }
+
+        [[nodiscard]] size_t size() const noexcept { return m_view.size(); }
+        [[nodiscard]] size_t find(uuid const& needle) const noexcept { return m_view.find(needle); }
+        void find(std::span<uuid const> needles, std::span<size_t> out_indices) const noexcept { m_view.find(needles, out_indices); }
+        [[nodiscard]] bool contains(uuid const& needle) const noexcept { return m_view.contains(needle); }
+
+    private:
+        void* m_data = nullptr;
+        size_t m_length = 0;
+        uuid_index_view m_view;
+
+        void swap(uuid_index_file& other) noexcept
+        {
+            std::swap(m_data, other.m_data);
+            std::swap(m_length, other.m_length);
+            std::swap(m_view, other.m_view);
+        }
+
+        std::errc map(std::filesystem::path const& path) noexcept
+        {
+#ifdef _WIN32
+            HANDLE const file = CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_DELETE, nullptr, OPEN_EXISTING, FILE_FLAG_RANDOM_ACCESS, nullptr);
+            if (file == INVALID_HANDLE_VALUE)
+            {
+                return std::errc::no_such_file_or_directory;
+            }
+
+            LARGE_INTEGER length;
+            HANDLE const mapping = GetFileSizeEx(file, &length) and length.QuadPart > 0 ? CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr) : nullptr;
+            CloseHandle(file);
+            if (mapping == nullptr)
+            {
+                return std::errc::invalid_argument;
+            }
+
+            m_data = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+            CloseHandle(mapping);
+            if (m_data == nullptr)
+            {
+                return std::errc::not_enough_memory;
+            }
+
+            m_length = static_cast<size_t>(length.QuadPart);
+#else
+            int const fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+            if (fd < 0)
+            {
+                return static_cast<std::errc>(errno);
+            }
+
+            struct stat status;
+            if (fstat(fd, &status) != 0 or status.st_size <= 0)
+            {
+                ::close(fd);
+                return std::errc::invalid_argument;
+            }
+
+            void* const data = mmap(nullptr, static_cast<size_t>(status.st_size), PROT_READ, MAP_SHARED, fd, 0);
+            int const map_error = errno;
+            ::close(fd);
+            if (data == MAP_FAILED)
+            {
+                return static_cast<std::errc>(map_error);
+            }
+
+            // Lookups jump around the file, so reading ahead of them only evicts useful pages
+            madvise(data, static_cast<size_t>(status.st_size), MADV_RANDOM);
+
+            m_data = data;
+            m_length = static_cast<size_t>(status.st_size);
+#endif
+            return {};
+        }
+    };
+
+    inline std::errc write_uuid_index(std::span<uuid const> sorted_ids, std::ostream& out)
+    {
+        if (not std::is_sorted(sorted_ids.begin(), sorted_ids.end()))
+        {
+            return std::errc::invalid_argument;
+        }
+
+        detail::index_header header{};
+        header.magic = detail::s_index_magic;
+        header.version = detail::s_index_version;
+        header.byte_order = detail::s_index_byte_order;
+        header.num_uuids = sorted_ids.size();
+
+        // Choose the shift so that the range of the set is split into about one bucket per four uuids
+        detail::index_key const min = sorted_ids.empty() ? detail::index_key{} : detail::to_index_key(sorted_ids.front());
+        detail::index_key const max = sorted_ids.empty() ? detail::index_key{} : detail::to_index_key(sorted_ids.back());
+        uint64_t const range_hi = max.hi - min.hi - (max.lo < min.lo ? 1 : 0);
+        uint64_t const range_bits = range_hi != 0 ? 64 + std::bit_width(range_hi) : std::bit_width(max.lo - min.lo);
+        uint64_t const bucket_bits = std::bit_width(std::max<uint64_t>(1, sorted_ids.size() / detail::s_index_uuids_per_bucket));
+
+        header.shift = range_bits > bucket_bits ? range_bits - bucket_bits : 0;
+        header.num_buckets = detail::bucket_of(max, min, header.shift) + 1;
+        header.min_hi = min.hi;
+        header.min_lo = min.lo;
+        header.buckets_offset = detail::align_index_offset(sizeof(header));
+        header.uuids_offset = detail::align_index_offset(header.buckets_offset + (header.num_buckets + 1) * sizeof(uint64_t));
+
+        std::array<char, 64> const padding{};
+        out.write(reinterpret_cast<char const*>(&header), sizeof(header));
+        out.write(padding.data(), static_cast<std::streamsize>(header.buckets_offset - sizeof(header)));
+
+        // The table entry of a bucket is the position of its first uuid, written in chunks as the uuids are walked
+        std::array<uint64_t, 4096> chunk;
+        size_t num_chunked = 0;
+        size_t position = 0;
+        for (uint64_t bucket = 0; bucket <= header.num_buckets; ++bucket)
+        {
+            while (position < sorted_ids.size() and detail::bucket_of(detail::to_index_key(sorted_ids[position]), min, header.shift) < bucket)
+            {
+                ++position;
+            }
+
+            chunk[num_chunked++] = position;
+            if (num_chunked == chunk.size() or bucket == header.num_buckets)
+            {
+                out.write(reinterpret_cast<char const*>(chunk.data()), static_cast<std::streamsize>(num_chunked * sizeof(uint64_t)));
+                num_chunked = 0;
+            }
+        }
+
+        uint64_t const table_end = header.buckets_offset + (header.num_buckets + 1) * sizeof(uint64_t);
+        out.write(padding.data(), static_cast<std::streamsize>(header.uuids_offset - table_end));
+        out.write(reinterpret_cast<char const*>(sorted_ids.data()), static_cast<std::streamsize>(sorted_ids.size_bytes()));
+
+        return out ? std::errc{} : std::errc::io_error;
+    }
+
+    inline std::errc write_uuid_index(std::span<uuid const> sorted_ids, std::filesystem::path const& path)
+    {
+        std::ofstream out(path, std::ios::binary | std::ios::trunc);
+        if (not out)
+        {
+            return std::errc::io_error;
+        }
+
+        std::errc const ec = write_uuid_index(sorted_ids, out);
+        out.close();
+        return ec != std::errc{} or out ? ec : std::errc::io_error;
+    }
+}
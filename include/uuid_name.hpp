@@ -0,0 +1,632 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstdint>
+#include <cstring>
+#include <span>
+#include <string_view>
+#include <utility>
+
+#include "uuid.hpp"
+
+namespace LambdaSnail::Uuid
+{
+    // The name spaces defined in appendix A of the RFC, for names that are domain names, URLs, ISO object identifiers
+    // and X.500 distinguished names
+
+    inline constexpr uuid namespace_dns(uuid::octet_set_t{ 0x6b, 0xa7, 0xb8, 0x10, 0x9d, 0xad, 0x11, 0xd1, 0x80, 0xb4, 0x00, 0xc0, 0x4f, 0xd4, 0x30, 0xc8 });
+    inline constexpr uuid namespace_url(uuid::octet_set_t{ 0x6b, 0xa7, 0xb8, 0x11, 0x9d, 0xad, 0x11, 0xd1, 0x80, 0xb4, 0x00, 0xc0, 0x4f, 0xd4, 0x30, 0xc8 });
+    inline constexpr uuid namespace_oid(uuid::octet_set_t{ 0x6b, 0xa7, 0xb8, 0x12, 0x9d, 0xad, 0x11, 0xd1, 0x80, 0xb4, 0x00, 0xc0, 0x4f, 0xd4, 0x30, 0xc8 });
+    inline constexpr uuid namespace_x500(uuid::octet_set_t{ 0x6b, 0xa7, 0xb8, 0x14, 0x9d, 0xad, 0x11, 0xd1, 0x80, 0xb4, 0x00, 0xc0, 0x4f, 0xd4, 0x30, 0xc8 });
+
+    namespace detail
+    {
+        /**
+         * The state of SHA-1 (h0 to h4) and MD5 (a to d) before the first block.
+         */
+        inline constexpr std::array<uint32_t, 5> s_sha1_initial_state = { 0x67452301, 0xEFCDAB89, 0x98BADCFE, 0x10325476, 0xC3D2E1F0 };
+        inline constexpr std::array<uint32_t, 4> s_md5_initial_state = { 0x67452301, 0xEFCDAB89, 0x98BADCFE, 0x10325476 };
+
+        inline uint32_t load_big_endian_32(uint8_t const* bytes) noexcept
+        {
+            return static_cast<uint32_t>(bytes[0]) << 24 | static_cast<uint32_t>(bytes[1]) << 16 | static_cast<uint32_t>(bytes[2]) << 8 | bytes[3];
+        }
+
+        inline uint32_t load_little_endian_32(uint8_t const* bytes) noexcept
+        {
+            return static_cast<uint32_t>(bytes[3]) << 24 | static_cast<uint32_t>(bytes[2]) << 16 | static_cast<uint32_t>(bytes[1]) << 8 | bytes[0];
+        }
+
+        inline void sha1_compress_baseline(std::array<uint32_t, 5>& state, uint8_t const* blocks, size_t num_blocks) noexcept
+        {
+            for (size_t block = 0; block < num_blocks; ++block, blocks += 64)
+            {
+                std::array<uint32_t, 16> w;
+                for (size_t t = 0; t < 16; ++t)
+                {
+                    w[t] = load_big_endian_32(blocks + 4 * t);
+                }
+
+                uint32_t a = state[0], b = state[1], c = state[2], d = state[3], e = state[4];
+                for (size_t t = 0; t < 80; ++t)
+                {
+                    // The message schedule is kept in a ring of the last 16 words
+                    if (t >= 16)
+                    {
+                        w[t % 16] = std::rotl(w[(t - 3) % 16] ^ w[(t - 8) % 16] ^ w[(t - 14) % 16] ^ w[t % 16], 1);
+                    }
+
+                    uint32_t f, k;
+                    if (t < 20)
+                    {
+                        f = (b & c) | (~b & d);
+                        k = 0x5A827999;
+                    }
+                    else if (t < 40)
+                    {
+                        f = b ^ c ^ d;
+                        k = 0x6ED9EBA1;
+                    }
+                    else if (t < 60)
+                    {
+                        f = (b & c) | (b & d) | (c & d);
+                        k = 0x8F1BBCDC;
+                    }
+                    else
+                    {
+                        f = b ^ c ^ d;
+                        k = 0xCA62C1D6;
+                    }
+
+                    uint32_t const temp = std::rotl(a, 5) + f + e + k + w[t % 16];
+                    e = d;
+                    d = c;
+                    c = std::rotl(b, 30);
+                    b = a;
+                    a = temp;
+                }
+
+                state[0] += a;
+                state[1] += b;
+                state[2] += c;
+                state[3] += d;
+                state[4] += e;
+            }
+        }
+
+        inline void md5_compress(std::array<uint32_t, 4>& state, uint8_t const* blocks, size_t num_blocks) noexcept
+        {
+            static constexpr std::array<uint32_t, 64> k = {
+                0xd76aa478, 0xe8c7b756, 0x242070db, 0xc1bdceee, 0xf57c0faf, 0x4787c62a, 0xa8304613, 0xfd469501,
+                0x698098d8, 0x8b44f7af, 0xffff5bb1, 0x895cd7be, 0x6b901122, 0xfd987193, 0xa679438e, 0x49b40821,
+                0xf61e2562, 0xc040b340, 0x265e5a51, 0xe9b6c7aa, 0xd62f105d, 0x02441453, 0xd8a1e681, 0xe7d3fbc8,
+                0x21e1cde6, 0xc33707d6, 0xf4d50d87, 0x455a14ed, 0xa9e3e905, 0xfcefa3f8, 0x676f02d9, 0x8d2a4c8a,
+                0xfffa3942, 0x8771f681, 0x6d9d6122, 0xfde5380c, 0xa4beea44, 0x4bdecfa9, 0xf6bb4b60, 0xbebfbc70,
+                0x289b7ec6, 0xeaa127fa, 0xd4ef3085, 0x04881d05, 0xd9d4d039, 0xe6db99e5, 0x1fa27cf8, 0xc4ac5665,
+                0xf4292244, 0x432aff97, 0xab9423a7, 0xfc93a039, 0x655b59c3, 0x8f0ccc92, 0xffeff47d, 0x85845dd1,
+                0x6fa87e4f, 0xfe2ce6e0, 0xa3014314, 0x4e0811a1, 0xf7537e82, 0xbd3af235, 0x2ad7d2bb, 0xeb86d391 };
+
+            static constexpr std::array<int, 16> shifts = { 7, 12, 17, 22, 5, 9, 14, 20, 4, 11, 16, 23, 6, 10, 15, 21 };
+
+            for (size_t block = 0; block < num_blocks; ++block, blocks += 64)
+            {
+                std::array<uint32_t, 16> m;
+                for (size_t i = 0; i < 16; ++i)
+                {
+                    m[i] = load_little_endian_32(blocks + 4 * i);
+                }
+
+                uint32_t a = state[0], b = state[1], c = state[2], d = state[3];
+                for (size_t i = 0; i < 64; ++i)
+                {
+                    uint32_t f;
+                    size_t g;
+                    if (i < 16)
+                    {
+                        f = (b & c) | (~b & d);
+                        g = i;
+                    }
+                    else if (i < 32)
+                    {
+                        f = (d & b) | (~d & c);
+                        g = (5 * i + 1) % 16;
+                    }
+                    else if (i < 48)
+                    {
+                        f = b ^ c ^ d;
+                        g = (3 * i + 5) % 16;
+                    }
+                    else
+                    {
+                        f = c ^ (b | ~d);
+                        g = (7 * i) % 16;
+                    }
+
+                    f += a + k[i] + m[g];
+                    a = d;
+                    d = c;
+                    c = b;
+                    b += std::rotl(f, shifts[i / 16 * 4 + i % 4]);
+                }
+
+                state[0] += a;
+                state[1] += b;
+                state[2] += c;
+                state[3] += d;
+            }
+        }
+
+#ifdef UUID_LIB_USE_SIMD
+        /**
+         * Four rounds of SHA-1 with the SHA extensions. The message words of a group of four rounds are computed from
+         * the previous groups with sha1msg1/sha1msg2 while the rounds run, as in Intel's reference code, and e is
+         * carried in the upper lane of e0/e1, which take turns.
+         */
+        template<int group>
+        UUID_LIB_TARGET("sha,sse4.1") UUID_LIB_ALWAYS_INLINE void sha1_rounds_shani(__m128i& abcd, __m128i& e0, __m128i& e1, __m128i (&msg)[4], uint8_t const* block) noexcept
+        {
+            __m128i const reverse_bytes = _mm_set_epi64x(0x0001020304050607ll, 0x08090a0b0c0d0e0fll);
+            __m128i& current = msg[group % 4];
+            __m128i& e = group % 2 == 0 ? e0 : e1;
+            __m128i& next_e = group % 2 == 0 ? e1 : e0;
+
+            if constexpr (group < 4)
+            {
+                current = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<__m128i const*>(block + 16 * group)), reverse_bytes);
+            }
+
+            e = group == 0 ? _mm_add_epi32(e, current) : _mm_sha1nexte_epu32(e, current);
+            next_e = abcd;
+
+            if constexpr (group >= 3 and group <= 18)
+            {
+                msg[(group + 1) % 4] = _mm_sha1msg2_epu32(msg[(group + 1) % 4], current);
+            }
+
+            abcd = _mm_sha1rnds4_epu32(abcd, e, group / 5);
+
+            if constexpr (group >= 1 and group <= 16)
+            {
+                msg[(group + 3) % 4] = _mm_sha1msg1_epu32(msg[(group + 3) % 4], current);
+            }
+
+            if constexpr (group >= 2 and group <= 17)
+            {
+                msg[(group + 2) % 4] = _mm_xor_si128(msg[(group + 2) % 4], current);
+            }
+        }
+
+        template<int... groups>
+        UUID_LIB_TARGET("sha,sse4.1") UUID_LIB_ALWAYS_INLINE void sha1_block_shani(__m128i& abcd, __m128i& e0, __m128i& e1, __m128i (&msg)[4], uint8_t const* block, std::integer_sequence<int, groups...>) noexcept
+        {
+            (sha1_rounds_shani<groups>(abcd, e0, e1, msg, block), ...);
+        }
+
+        UUID_LIB_TARGET("sha,sse4.1") inline void sha1_compress_shani(std::array<uint32_t, 5>& state, uint8_t const* blocks, size_t num_blocks) noexcept
+        {
+            // The instructions keep a in the upper lane, so the state is loaded in reverse order
+            __m128i abcd = _mm_shuffle_epi32(_mm_loadu_si128(reinterpret_cast<__m128i const*>(state.data())), 0x1B);
+            __m128i e0 = _mm_set_epi32(static_cast<int>(state[4]), 0, 0, 0);
+            __m128i e1 = _mm_setzero_si128();
+
+            for (size_t block = 0; block < num_blocks; ++block, blocks += 64)
+            {
+                __m128i const abcd_save = abcd;
+                __m128i const e0_save = e0;
+                __m128i msg[4];
+
+                sha1_block_shani(abcd, e0, e1, msg, blocks, std::make_integer_sequence<int, 20>());
+
+                e0 = _mm_sha1nexte_epu32(e0, e0_save);
+                abcd = _mm_add_epi32(abcd, abcd_save);
+            }
+
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(state.data()), _mm_shuffle_epi32(abcd, 0x1B));
+            state[4] = static_cast<uint32_t>(_mm_extract_epi32(e0, 3));
+        }
+#endif
+
+        inline void sha1_compress(std::array<uint32_t, 5>& state, uint8_t const* blocks, size_t num_blocks) noexcept
+        {
+#ifdef UUID_LIB_USE_SIMD
+            if (has_sha())
+            {
+                sha1_compress_shani(state, blocks, num_blocks);
+                return;
+            }
+#endif
+            sha1_compress_baseline(state, blocks, num_blocks);
+        }
+
+        /**
+         * The number of 64-byte blocks of a name in a name space after padding: the name space, the name, a 0x80
+         * octet and the 64-bit message length.
+         */
+        inline size_t num_name_blocks(std::string_view name) noexcept
+        {
+            return (sizeof(uuid::octet_set_t) + name.size() + 1 + sizeof(uint64_t) + 63) / 64;
+        }
+
+        /**
+         * Writes the padded message for a name in a name space to out, which must have room for num_name_blocks(name)
+         * blocks. SHA-1 stores the message length in big endian, MD5 in little endian.
+         */
+        inline void pad_name(uuid const& name_space, std::string_view name, bool big_endian_length, uint8_t* out) noexcept
+        {
+            size_t const size = sizeof(uuid::octet_set_t) + name.size();
+            size_t const padded_size = num_name_blocks(name) * 64;
+
+            memcpy(out, name_space.octets.data(), sizeof(uuid::octet_set_t));
+            memcpy(out + sizeof(uuid::octet_set_t), name.data(), name.size());
+            out[size] = 0x80;
+            memset(out + size + 1, 0, padded_size - size - 1);
+
+            uint64_t const bits = static_cast<uint64_t>(size) * 8;
+            for (size_t i = 0; i < sizeof(uint64_t); ++i)
+            {
+                out[padded_size - 1 - i] = static_cast<uint8_t>(big_endian_length ? bits >> 8 * i : bits >> 8 * (7 - i));
+            }
+        }
+
+        /**
+         * Hashes a name in a name space with a compression function. Only the first block (which holds the name space)
+         * and the last one or two (which hold the padding) are copied; the blocks in between are read from the name.
+         */
+        template<typename state_t, typename compress_t>
+        void hash_name(state_t& state, uuid const& name_space, std::string_view name, bool big_endian_length, compress_t&& compress) noexcept
+        {
+            alignas(16) std::array<uint8_t, 128> buffer;
+            size_t constexpr prefix_size = sizeof(uuid::octet_set_t);
+
+            if (prefix_size + name.size() + 1 + sizeof(uint64_t) <= buffer.size())
+            {
+                pad_name(name_space, name, big_endian_length, buffer.data());
+                compress(state, buffer.data(), num_name_blocks(name));
+                return;
+            }
+
+            // The first block: the name space and the start of the name
+            size_t const head = 64 - prefix_size;
+            memcpy(buffer.data(), name_space.octets.data(), prefix_size);
+            memcpy(buffer.data() + prefix_size, name.data(), head);
+            compress(state, buffer.data(), 1);
+
+            size_t const num_middle = (name.size() - head) / 64;
+            compress(state, reinterpret_cast<uint8_t const*>(name.data() + head), num_middle);
+
+            // The rest of the name and the padding, in one or two blocks
+            std::string_view const tail = name.substr(head + 64 * num_middle);
+            size_t const padded_size = tail.size() + 1 + sizeof(uint64_t) <= 64 ? 64 : 128;
+            memcpy(buffer.data(), tail.data(), tail.size());
+            buffer[tail.size()] = 0x80;
+            memset(buffer.data() + tail.size() + 1, 0, padded_size - tail.size() - 1);
+
+            uint64_t const bits = static_cast<uint64_t>(prefix_size + name.size()) * 8;
+            for (size_t i = 0; i < sizeof(uint64_t); ++i)
+            {
+                buffer[padded_size - 1 - i] = static_cast<uint8_t>(big_endian_length ? bits >> 8 * i : bits >> 8 * (7 - i));
+            }
+
+            compress(state, buffer.data(), padded_size / 64);
+        }
+
+        /**
+         * Sets the version and variant bits of a name-based uuid, whose octets hold the start of the hash.
+         */
+        inline void set_name_based_bits(uuid::octet_set_t& octets, uint8_t version) noexcept
+        {
+            octets[6] = static_cast<uint8_t>((octets[6] & 0x0F) | version << 4);
+            octets[8] = static_cast<uint8_t>((octets[8] & 0x3F) | 0x80);
+        }
+
+        /**
+         * Writes the first 128 bits of a SHA-1 state (h0 to h3, in big endian) to a uuid, with the v5 bits.
+         */
+        inline void sha1_state_to_uuid(uint32_t h0, uint32_t h1, uint32_t h2, uint32_t h3, uuid& out_id) noexcept
+        {
+            std::array<uint32_t, 4> const words = { h0, h1, h2, h3 };
+            for (size_t i = 0; i < words.size(); ++i)
+            {
+                out_id.octets[4 * i] = static_cast<uint8_t>(words[i] >> 24);
+                out_id.octets[4 * i + 1] = static_cast<uint8_t>(words[i] >> 16);
+                out_id.octets[4 * i + 2] = static_cast<uint8_t>(words[i] >> 8);
+                out_id.octets[4 * i + 3] = static_cast<uint8_t>(words[i]);
+            }
+
+            set_name_based_bits(out_id.octets, 5);
+        }
+
+        inline void create_uuid_v5(uuid const& name_space, std::string_view name, uuid& out_id) noexcept
+        {
+            std::array<uint32_t, 5> state = s_sha1_initial_state;
+            hash_name(state, name_space, name, true, [](std::array<uint32_t, 5>& s, uint8_t const* blocks, size_t num_blocks)
+            {
+                sha1_compress(s, blocks, num_blocks);
+            });
+
+            sha1_state_to_uuid(state[0], state[1], state[2], state[3], out_id);
+        }
+
+        inline void create_uuid_v3(uuid const& name_space, std::string_view name, uuid& out_id) noexcept
+        {
+            std::array<uint32_t, 4> state = s_md5_initial_state;
+            hash_name(state, name_space, name, false, [](std::array<uint32_t, 4>& s, uint8_t const* blocks, size_t num_blocks)
+            {
+                md5_compress(s, blocks, num_blocks);
+            });
+
+            // The MD5 digest is the state in little endian
+            for (size_t i = 0; i < state.size(); ++i)
+            {
+                for (size_t k = 0; k < 4; ++k)
+                {
+                    out_id.octets[4 * i + k] = static_cast<uint8_t>(state[i] >> 8 * k);
+                }
+            }
+
+            set_name_based_bits(out_id.octets, 3);
+        }
+
+        /**
+         * Names whose padded message is longer than this many blocks are hashed one at a time by the batch function.
+         */
+        inline constexpr size_t s_multi_buffer_max_blocks = 4;
+
+#ifdef UUID_LIB_USE_SIMD
+        // Multi-buffer SHA-1 hashes one message per 32-bit lane of a vector register, so that eight (AVX2) or sixteen
+        // (AVX-512) names are hashed with the instructions it takes to hash one. The operations on the registers are
+        // given by an ops type, and the rounds are written once in sha1_multi_buffer_impl. The operations update their
+        // first argument in place, so that no vector is passed or returned by value from the impl, which is compiled
+        // without the instruction set and only gets it when inlined into the sha1_multi_buffer_* entry points.
+
+        struct sha1_ops_avx512
+        {
+            using vector_t = __m512i;
+            static inline constexpr size_t s_lanes = 16;
+
+            UUID_LIB_TARGET("avx512f") static void set1(vector_t& v, uint32_t value) noexcept { v = _mm512_set1_epi32(static_cast<int>(value)); }
+            UUID_LIB_TARGET("avx512f") static void load(vector_t& v, uint32_t const* words) noexcept { v = _mm512_load_si512(words); }
+            UUID_LIB_TARGET("avx512f") static void store(uint32_t* words, vector_t const& v) noexcept { _mm512_store_si512(words, v); }
+
+            // w = rotl(w ^ a ^ b ^ c, 1), the message schedule
+            UUID_LIB_TARGET("avx512f") static void schedule(vector_t& w, vector_t const& a, vector_t const& b, vector_t const& c) noexcept
+            {
+                w = _mm512_rol_epi32(_mm512_ternarylogic_epi32(_mm512_xor_si512(w, a), b, c, 0x96), 1);
+            }
+
+            // The round functions as ternary logic: choose, parity and majority. f = function(b, c, d)
+            UUID_LIB_TARGET("avx512f") static void ch(vector_t& f, vector_t const& b, vector_t const& c, vector_t const& d) noexcept { f = _mm512_ternarylogic_epi32(b, c, d, 0xCA); }
+            UUID_LIB_TARGET("avx512f") static void parity(vector_t& f, vector_t const& b, vector_t const& c, vector_t const& d) noexcept { f = _mm512_ternarylogic_epi32(b, c, d, 0x96); }
+            UUID_LIB_TARGET("avx512f") static void maj(vector_t& f, vector_t const& b, vector_t const& c, vector_t const& d) noexcept { f = _mm512_ternarylogic_epi32(b, c, d, 0xE8); }
+
+            // e = rotl(a, 5) + f + e + k + w, and b = rotl(b, 30)
+            UUID_LIB_TARGET("avx512f") static void round(vector_t const& a, vector_t& b, vector_t& e, vector_t const& f, uint32_t k, vector_t const& w) noexcept
+            {
+                __m512i const sum = _mm512_add_epi32(_mm512_add_epi32(e, _mm512_set1_epi32(static_cast<int>(k))), _mm512_add_epi32(f, w));
+                e = _mm512_add_epi32(_mm512_rol_epi32(a, 5), sum);
+                b = _mm512_rol_epi32(b, 30);
+            }
+
+            // h += v in the lanes that have more than block blocks
+            UUID_LIB_TARGET("avx512f") static void add_active(vector_t& h, vector_t const& v, vector_t const& num_blocks, size_t block) noexcept
+            {
+                h = _mm512_mask_add_epi32(h, _mm512_cmpgt_epi32_mask(num_blocks, _mm512_set1_epi32(static_cast<int>(block))), h, v);
+            }
+        };
+
+        struct sha1_ops_avx2
+        {
+            using vector_t = __m256i;
+            static inline constexpr size_t s_lanes = 8;
+
+            UUID_LIB_TARGET("avx2") static void set1(vector_t& v, uint32_t value) noexcept { v = _mm256_set1_epi32(static_cast<int>(value)); }
+            UUID_LIB_TARGET("avx2") static void load(vector_t& v, uint32_t const* words) noexcept { v = _mm256_load_si256(reinterpret_cast<__m256i const*>(words)); }
+            UUID_LIB_TARGET("avx2") static void store(uint32_t* words, vector_t const& v) noexcept { _mm256_store_si256(reinterpret_cast<__m256i*>(words), v); }
+
+            UUID_LIB_TARGET("avx2") static void schedule(vector_t& w, vector_t const& a, vector_t const& b, vector_t const& c) noexcept
+            {
+                __m256i const x = _mm256_xor_si256(_mm256_xor_si256(w, a), _mm256_xor_si256(b, c));
+                w = _mm256_or_si256(_mm256_slli_epi32(x, 1), _mm256_srli_epi32(x, 31));
+            }
+
+            UUID_LIB_TARGET("avx2") static void ch(vector_t& f, vector_t const& b, vector_t const& c, vector_t const& d) noexcept { f = _mm256_xor_si256(d, _mm256_and_si256(b, _mm256_xor_si256(c, d))); }
+            UUID_LIB_TARGET("avx2") static void parity(vector_t& f, vector_t const& b, vector_t const& c, vector_t const& d) noexcept { f = _mm256_xor_si256(_mm256_xor_si256(b, c), d); }
+            UUID_LIB_TARGET("avx2") static void maj(vector_t& f, vector_t const& b, vector_t const& c, vector_t const& d) noexcept { f = _mm256_or_si256(_mm256_and_si256(b, c), _mm256_and_si256(d, _mm256_or_si256(b, c))); }
+
+            UUID_LIB_TARGET("avx2") static void round(vector_t const& a, vector_t& b, vector_t& e, vector_t const& f, uint32_t k, vector_t const& w) noexcept
+            {
+                __m256i const sum = _mm256_add_epi32(_mm256_add_epi32(e, _mm256_set1_epi32(static_cast<int>(k))), _mm256_add_epi32(f, w));
+                e = _mm256_add_epi32(_mm256_or_si256(_mm256_slli_epi32(a, 5), _mm256_srli_epi32(a, 27)), sum);
+                b = _mm256_or_si256(_mm256_slli_epi32(b, 30), _mm256_srli_epi32(b, 2));
+            }
+
+            UUID_LIB_TARGET("avx2") static void add_active(vector_t& h, vector_t const& v, vector_t const& num_blocks, size_t block) noexcept
+            {
+                __m256i const active = _mm256_cmpgt_epi32(num_blocks, _mm256_set1_epi32(static_cast<int>(block)));
+                h = _mm256_add_epi32(h, _mm256_and_si256(v, active));
+            }
+        };
+
+        /**
+         * Hashes one message per lane. words holds the message words in big endian order, transposed so that word t of
+         * block b of all lanes is at words[(16 * b + t) * lanes]. The lanes may have different numbers of blocks; a lane
+         * keeps its state once its blocks are done. The final h0 to h3 of each lane are written to out_state[i * lanes].
+         */
+        template<typename ops_t>
+        UUID_LIB_ALWAYS_INLINE void sha1_multi_buffer_impl(uint32_t const* words, uint32_t const* num_blocks, size_t max_blocks, uint32_t* out_state) noexcept
+        {
+            using vector_t = typename ops_t::vector_t;
+            size_t constexpr lanes = ops_t::s_lanes;
+
+            vector_t h[5];
+            for (size_t i = 0; i < 5; ++i)
+            {
+                ops_t::set1(h[i], s_sha1_initial_state[i]);
+            }
+
+            vector_t blocks;
+            ops_t::load(blocks, num_blocks);
+            for (size_t block = 0; block < max_blocks; ++block)
+            {
+                vector_t w[16];
+                vector_t a = h[0], b = h[1], c = h[2], d = h[3], e = h[4];
+
+                for (size_t t = 0; t < 80; ++t)
+                {
+                    if (t < 16)
+                    {
+                        ops_t::load(w[t], words + (16 * block + t) * lanes);
+                    }
+                    else
+                    {
+                        ops_t::schedule(w[t % 16], w[(t - 3) % 16], w[(t - 8) % 16], w[(t - 14) % 16]);
+                    }
+
+                    vector_t f;
+                    uint32_t k;
+                    if (t < 20)
+                    {
+                        ops_t::ch(f, b, c, d);
+                        k = 0x5A827999;
+                    }
+                    else if (t < 40)
+                    {
+                        ops_t::parity(f, b, c, d);
+                        k = 0x6ED9EBA1;
+                    }
+                    else if (t < 60)
+                    {
+                        ops_t::maj(f, b, c, d);
+                        k = 0x8F1BBCDC;
+                    }
+                    else
+                    {
+                        ops_t::parity(f, b, c, d);
+                        k = 0xCA62C1D6;
+                    }
+
+                    // e becomes the new a and b the new c, the others move down
+                    ops_t::round(a, b, e, f, k, w[t % 16]);
+                    vector_t const temp = e;
+                    e = d;
+                    d = c;
+                    c = b;
+                    b = a;
+                    a = temp;
+                }
+
+                ops_t::add_active(h[0], a, blocks, block);
+                ops_t::add_active(h[1], b, blocks, block);
+                ops_t::add_active(h[2], c, blocks, block);
+                ops_t::add_active(h[3], d, blocks, block);
+                ops_t::add_active(h[4], e, blocks, block);
+            }
+
+            for (size_t i = 0; i < 4; ++i)
+            {
+                ops_t::store(out_state + i * lanes, h[i]);
+            }
+        }
+
+        UUID_LIB_TARGET("avx512f") inline void sha1_multi_buffer_avx512(uint32_t const* words, uint32_t const* num_blocks, size_t max_blocks, uint32_t* out_state) noexcept
+        {
+            sha1_multi_buffer_impl<sha1_ops_avx512>(words, num_blocks, max_blocks, out_state);
+        }
+
+        UUID_LIB_TARGET("avx2") inline void sha1_multi_buffer_avx2(uint32_t const* words, uint32_t const* num_blocks, size_t max_blocks, uint32_t* out_state) noexcept
+        {
+            sha1_multi_buffer_impl<sha1_ops_avx2>(words, num_blocks, max_blocks, out_state);
+        }
+
+        /**
+         * Creates v5 uuids for a batch of names, a group of lanes at a time. Names too long for the buffers are
+         * hashed on their own.
+         */
+        template<size_t lanes, typename hash_t>
+        void create_uuids_v5_multi_buffer(uuid const& name_space, std::span<std::string_view const> names, std::span<uuid> out_ids, hash_t&& hash) noexcept
+        {
+            alignas(64) std::array<uint32_t, 16 * s_multi_buffer_max_blocks * lanes> words;
+            alignas(64) std::array<uint32_t, lanes> num_blocks;
+            alignas(64) std::array<uint32_t, 4 * lanes> state;
+            std::array<size_t, lanes> indices;
+            std::array<uint8_t, 64 * s_multi_buffer_max_blocks> message;
+
+            size_t next = 0;
+            while (next < names.size())
+            {
+                // Fill the lanes with the next names that fit
+                size_t num_lanes = 0;
+                size_t max_blocks = 0;
+                for (; next < names.size() and num_lanes < lanes; ++next)
+                {
+                    size_t const blocks = num_name_blocks(names[next]);
+                    if (blocks > s_multi_buffer_max_blocks)
+                    {
+                        create_uuid_v5(name_space, names[next], out_ids[next]);
+                        continue;
+                    }
+
+                    pad_name(name_space, names[next], true, message.data());
+                    for (size_t t = 0; t < 16 * blocks; ++t)
+                    {
+                        words[t * lanes + num_lanes] = load_big_endian_32(message.data() + 4 * t);
+                    }
+
+                    num_blocks[num_lanes] = static_cast<uint32_t>(blocks);
+                    indices[num_lanes] = next;
+                    max_blocks = std::max(max_blocks, blocks);
+                    ++num_lanes;
+                }
+
+                if (num_lanes == 0)
+                {
+                    break;
+                }
+
+                // Idle lanes, and the blocks past the end of a shorter message, are hashed too and then discarded, so
+                // they are zeroed rather than hashed from whatever an earlier group left in the buffer
+                std::fill(num_blocks.begin() + num_lanes, num_blocks.end(), 0);
+                for (size_t lane = 0; lane < lanes; ++lane)
+                {
+                    for (size_t t = 16 * num_blocks[lane]; t < 16 * max_blocks; ++t)
+                    {
+                        words[t * lanes + lane] = 0;
+                    }
+                }
+
+                hash(words.data(), num_blocks.data(), max_blocks, state.data());
+
+                for (size_t lane = 0; lane < num_lanes; ++lane)
+                {
+                    sha1_state_to_uuid(state[lane], state[lanes + lane], state[2 * lanes + lane], state[3 * lanes + lane], out_ids[indices[lane]]);
+                }
+            }
+        }
+#endif
+
+        inline void create_uuids_v5(uuid const& name_space, std::span<std::string_view const> names, std::span<uuid> out_ids) noexcept
+        {
+#ifdef UUID_LIB_USE_SIMD
+            if (has_avx512f())
+            {
+                create_uuids_v5_multi_buffer<sha1_ops_avx512::s_lanes>(name_space, names, out_ids, &sha1_multi_buffer_avx512);
+                return;
+            }
+
+            // One message at a time with the SHA extensions is about as fast as eight with AVX2, so AVX2 is only used
+            // without them
+            if (has_avx2() and not has_sha())
+            {
+                create_uuids_v5_multi_buffer<sha1_ops_avx2::s_lanes>(name_space, names, out_ids, &sha1_multi_buffer_avx2);
+                return;
+            }
+#endif
+            for (size_t i = 0; i < names.size(); ++i)
+            {
+                create_uuid_v5(name_space, names[i], out_ids[i]);
+            }
+        }
+    }
+}
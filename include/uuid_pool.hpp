@@ -0,0 +1,305 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <thread>
+
+#include "uuid.hpp"
+#include "uuid_concurrent.hpp"
+
+namespace LambdaSnail::Uuid
+{
+    /**
+     * The kind of uuid a uuid_pool hands out.
+     */
+    enum class uuid_pool_kind
+    {
+        v4,
+
+        /**
+         * Strictly increasing version seven uuids, see uuid_factory::create_uuid_v7_monotonic.
+         */
+        v7
+    };
+
+    struct uuid_pool_options
+    {
+        /**
+         * The number of uuids the pool holds. This is rounded up to a power of two.
+         */
+        size_t depth = 4096;
+
+        /**
+         * When a consumer leaves fewer uuids than this in the pool, the producer thread is woken to fill it up again.
+         * Must be less than the depth.
+         */
+        size_t low_water_mark = 1024;
+    };
+
+    /**
+     * Hands out uuids that a background thread has created ahead of time, so that taking one is a few atomic
+     * operations with no clock reads or random numbers on the calling thread. This moves the cost of creating uuids
+     * out of latency sensitive code, at the price of one thread that wakes up when the pool runs low.
+     *
+     * The uuids are kept in a bounded lock-free ring (a sequence number per slot, as in Dmitry Vyukov's MPMC queue)
+     * that any number of threads can take from. The producer creates a block at a time with the batch functions of
+     * uuid_factory, and then sleeps until a consumer finds the pool below the low-water mark. If the pool runs empty,
+     * pop() creates the uuid on the calling thread instead, with concurrent_uuid_factory.
+     *
+     * Note that a version seven uuid carries the time it was created, not the time it was taken from the pool, so its
+     * timestamp lags by however long it waited. uuids taken from the pool are unique, but not ordered between threads
+     * or with the ones created inline when the pool is empty.
+     *
+     * @tparam rng_t The type of the random number generator, see jumpable_generator.
+     * @tparam clock_policy_t Where v7 timestamps are read from, see uuid_clock.hpp.
+     */
+    template<jumpable_generator rng_t = xoroshiro128pp, uuid_clock clock_policy_t = system_clock_policy>
+    class uuid_pool
+    {
+    public:
+        /**
+         * Starts the producer thread, which begins filling the pool right away.
+         * @param kind The kind of uuid to create.
+         * @param options The size of the pool and when to refill it.
+         */
+        explicit uuid_pool(uuid_pool_kind kind, uuid_pool_options options = {});
+
+        /**
+         * Stops and joins the producer thread. No thread may use the pool any more.
+         */
+        ~uuid_pool();
+
+        uuid_pool(uuid_pool const&) = delete;
+        uuid_pool& operator=(uuid_pool const&) = delete;
+
+        /**
+         * Takes a uuid from the pool, or creates one on the calling thread if the pool is empty.
+         * @param out_id The output uuid.
+         */
+        void pop(uuid& out_id) noexcept;
+
+        /**
+         * Takes a uuid from the pool, without falling back to creating one.
+         * @param out_id The output uuid, which is left unchanged if the pool is empty.
+         * @return True if a uuid was taken, false if the pool is empty.
+         */
+        [[nodiscard]] bool try_pop(uuid& out_id) noexcept;
+
+        /**
+         * Returns the number of uuids in the pool. The value may be out of date as soon as it is returned.
+         */
+        [[nodiscard]] size_t size() const noexcept;
+
+        /**
+         * Returns the number of calls to pop() that found the pool empty. If this grows, the pool is too small or the
+         * low-water mark too low for the rate uuids are taken at.
+         */
+        [[nodiscard]] uint64_t num_fallbacks() const noexcept { return m_num_fallbacks.load(std::memory_order_relaxed); }
+
+    private:
+        /**
+         * The producer creates this many uuids at a time.
+         */
+        static inline constexpr size_t s_block_size = 256;
+
+        struct slot
+        {
+            /**
+             * Equal to the position + 1 when the slot holds a uuid for the consumer at that position, and to the
+             * position + depth when it is free for the producer to write the uuid for that position.
+             */
+            std::atomic<uint64_t> sequence;
+            uuid id;
+        };
+
+        uuid_pool_kind const m_kind;
+        uint64_t const m_mask;
+        size_t const m_low_water_mark;
+        std::unique_ptr<slot[]> m_slots;
+
+        // Written by the producer only, once per block
+        alignas(64) std::atomic<uint64_t> m_enqueue_position = 0;
+
+        alignas(64) std::atomic<uint64_t> m_dequeue_position = 0;
+
+        alignas(64) std::atomic<bool> m_refill_requested = false;
+        std::atomic<uint64_t> m_num_fallbacks = 0;
+
+        std::jthread m_producer;
+
+        void produce(std::stop_token const& stop) noexcept;
+        void request_refill() noexcept;
+    };
+
+    template<jumpable_generator rng_t, uuid_clock clock_policy_t>
+    uuid_pool<rng_t, clock_policy_t>::uuid_pool(uuid_pool_kind kind, uuid_pool_options options) :
+        m_kind(kind),
+        m_mask(std::bit_ceil(std::max<size_t>(options.depth, 2)) - 1),
+        m_low_water_mark(std::min<size_t>(options.low_water_mark, m_mask)),
+        m_slots(std::make_unique<slot[]>(m_mask + 1))
+    {
+        for (uint64_t i = 0; i <= m_mask; ++i)
+        {
+            m_slots[i].sequence.store(i, std::memory_order_relaxed);
+        }
+
+        m_producer = std::jthread([this](std::stop_token const& stop) { produce(stop); });
+    }
+
+    template<jumpable_generator rng_t, uuid_clock clock_policy_t>
+    uuid_pool<rng_t, clock_policy_t>::~uuid_pool()
+    {
+        m_producer.request_stop();
+        m_refill_requested.store(true, std::memory_order_release);
+        m_refill_requested.notify_one();
+        m_producer.join();
+    }
+
+    template<jumpable_generator rng_t, uuid_clock clock_policy_t>
+    void uuid_pool<rng_t, clock_policy_t>::pop(uuid& out_id) noexcept
+    {
+        if (try_pop(out_id)) [[likely]]
+        {
+            return;
+        }
+
+        m_num_fallbacks.fetch_add(1, std::memory_order_relaxed);
+        request_refill();
+
+        if (m_kind == uuid_pool_kind::v4)
+        {
+            concurrent_uuid_factory<rng_t, clock_policy_t>::local().create_uuid_v4(out_id);
+        }
+        else
+        {
+            concurrent_uuid_factory<rng_t, clock_policy_t>::local().create_uuid_v7_monotonic(out_id);
+        }
+    }
+
+    template<jumpable_generator rng_t, uuid_clock clock_policy_t>
+    bool uuid_pool<rng_t, clock_policy_t>::try_pop(uuid& out_id) noexcept
+    {
+        uint64_t position = m_dequeue_position.load(std::memory_order_relaxed);
+        while (true)
+        {
+            slot& s = m_slots[position & m_mask];
+            uint64_t const sequence = s.sequence.load(std::memory_order_acquire);
+            int64_t const difference = static_cast<int64_t>(sequence - (position + 1));
+
+            if (difference == 0)
+            {
+                // On failure, position is reloaded and the slot it points to is checked again
+                if (m_dequeue_position.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+                {
+                    out_id = s.id;
+                    s.sequence.store(position + m_mask + 1, std::memory_order_release);
+                    break;
+                }
+            }
+            else if (difference < 0)
+            {
+                // The producer has not written this slot yet, so the pool is empty
+                return false;
+            }
+            else
+            {
+                // Another consumer took this slot after position was loaded
+                position = m_dequeue_position.load(std::memory_order_relaxed);
+            }
+        }
+
+        if (m_enqueue_position.load(std::memory_order_relaxed) - (position + 1) < m_low_water_mark)
+        {
+            request_refill();
+        }
+
+        return true;
+    }
+
+    template<jumpable_generator rng_t, uuid_clock clock_policy_t>
+    size_t uuid_pool<rng_t, clock_policy_t>::size() const noexcept
+    {
+        uint64_t const dequeue = m_dequeue_position.load(std::memory_order_relaxed);
+        uint64_t const enqueue = m_enqueue_position.load(std::memory_order_relaxed);
+        return enqueue > dequeue ? enqueue - dequeue : 0;
+    }
+
+    template<jumpable_generator rng_t, uuid_clock clock_policy_t>
+    void uuid_pool<rng_t, clock_policy_t>::request_refill() noexcept
+    {
+        // The load keeps consumers from writing the flag's cache line on every pop while a refill is pending
+        if (not m_refill_requested.load(std::memory_order_relaxed) and not m_refill_requested.exchange(true, std::memory_order_acq_rel))
+        {
+            m_refill_requested.notify_one();
+        }
+    }
+
+    template<jumpable_generator rng_t, uuid_clock clock_policy_t>
+    void uuid_pool<rng_t, clock_policy_t>::produce(std::stop_token const& stop) noexcept
+    {
+        // The producer thread gets its own stream of random numbers, like any other thread
+        uuid_factory<rng_t, clock_policy_t>& factory = concurrent_uuid_factory<rng_t, clock_policy_t>::local();
+
+        std::array<uuid, s_block_size> block;
+        size_t const block_size = std::min<size_t>(s_block_size, m_mask + 1);
+        size_t block_position = block_size;
+        uint64_t position = 0;
+
+        while (not stop.stop_requested())
+        {
+            // Fill the pool until the slot at the next position has not been freed by a consumer yet
+            while (not stop.stop_requested())
+            {
+                if (block_position == block_size)
+                {
+                    std::span<uuid> const ids(block.data(), block_size);
+                    if (m_kind == uuid_pool_kind::v4)
+                    {
+                        factory.create_uuids_v4(ids);
+                    }
+                    else
+                    {
+                        factory.create_uuids_v7_monotonic(ids);
+                    }
+
+                    block_position = 0;
+                }
+
+                uint64_t const start = position;
+                for (; block_position < block_size; ++block_position, ++position)
+                {
+                    slot& s = m_slots[position & m_mask];
+                    if (s.sequence.load(std::memory_order_acquire) != position)
+                    {
+                        break;
+                    }
+
+                    s.id = block[block_position];
+                    s.sequence.store(position + 1, std::memory_order_release);
+                }
+
+                m_enqueue_position.store(position, std::memory_order_relaxed);
+                if (position == start or block_position < block_size)
+                {
+                    break;
+                }
+            }
+
+            // Reading the flag with an exchange synchronizes with the consumer that set it, so the slot check below
+            // sees the uuids it took. Consumers that took uuids while the pool was being filled may have left it
+            // above the low-water mark without requesting a refill, so the producer only sleeps once the next slot is
+            // taken, that is when the pool is full. A consumer that sets the flag after the exchange makes the wait
+            // return at once, and so does the destructor, which requests the stop before setting the flag
+            m_refill_requested.exchange(false, std::memory_order_acq_rel);
+            if (not stop.stop_requested() and m_slots[position & m_mask].sequence.load(std::memory_order_acquire) != position)
+            {
+                m_refill_requested.wait(false, std::memory_order_acquire);
+            }
+        }
+    }
+}
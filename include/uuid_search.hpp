@@ -0,0 +1,282 @@
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <cstdint>
+#include <span>
+
+#include "uuid.hpp"
+
+namespace LambdaSnail::Uuid
+{
+    /**
+     * Returns the index of the first uuid in the haystack that is equal to the needle, or haystack.size() if there is
+     * none. The haystack is scanned linearly, comparing two uuids per instruction with AVX2 and four with AVX-512.
+     * For small to medium arrays this is often faster than hashing.
+     */
+    [[nodiscard]] size_t uuid_index_of(std::span<uuid const> haystack, uuid const& needle) noexcept;
+
+    /**
+     * Finds several needles in one pass over the haystack. For each needle, the index of its first occurrence (or
+     * haystack.size() if it does not occur) is written to the corresponding position in out_indices.
+     * @param haystack The uuids to search.
+     * @param needles The uuids to look for.
+     * @param out_indices The output indices. Must be at least as large as needles.
+     */
+    void uuid_index_of(std::span<uuid const> haystack, std::span<uuid const> needles, std::span<size_t> out_indices) noexcept;
+
+    /**
+     * Returns an iterator to the first uuid in the haystack that is equal to the needle, or haystack.end().
+     */
+    [[nodiscard]] std::span<uuid const>::iterator uuid_find(std::span<uuid const> haystack, uuid const& needle) noexcept;
+
+    /**
+     * Returns true if the haystack holds a uuid equal to the needle.
+     */
+    [[nodiscard]] bool uuid_contains(std::span<uuid const> haystack, uuid const& needle) noexcept;
+
+    /**
+     * Returns the number of uuids in the haystack that are equal to the needle.
+     */
+    [[nodiscard]] size_t uuid_count(std::span<uuid const> haystack, uuid const& needle) noexcept;
+
+    namespace detail
+    {
+        /**
+         * The number of uuids compared per step of the search loops.
+         */
+        inline constexpr size_t s_search_block_size = 8;
+
+        // Each block matcher compares a block of eight uuids against the needle. Bit 2i of the result is set if
+        // uuid i is equal to the needle, so the index of a match is countr_zero(mask) / 2 and the number of matches
+        // is popcount(mask).
+
+#ifdef UUID_LIB_USE_SIMD
+        struct block_matcher_avx512
+        {
+            UUID_LIB_TARGET("avx512f") uint32_t operator()(uuid const* block, uuid const& needle) const noexcept
+            {
+                // Four uuids per register. A uuid matches when both of its 64-bit halves do
+                uint64_t lo, hi;
+                memcpy(&lo, needle.octets.data(), sizeof(uint64_t));
+                memcpy(&hi, needle.octets.data() + 8, sizeof(uint64_t));
+                __m512i const n = _mm512_set_epi64(hi, lo, hi, lo, hi, lo, hi, lo);
+                uint32_t mask = 0;
+                for (size_t r = 0; r < 2; ++r)
+                {
+                    __m512i const v = _mm512_loadu_si512(block + 4 * r);
+                    uint32_t const halves = _mm512_cmpeq_epi64_mask(v, n);
+                    mask |= (halves & (halves >> 1) & 0x55) << (8 * r);
+                }
+
+                return mask;
+            }
+        };
+
+        struct block_matcher_avx2
+        {
+            UUID_LIB_TARGET("avx2") uint32_t operator()(uuid const* block, uuid const& needle) const noexcept
+            {
+                // Two uuids per register
+                __m256i const n = _mm256_broadcastsi128_si256(_mm_load_si128(reinterpret_cast<__m128i const*>(needle.octets.data())));
+                uint32_t mask = 0;
+                for (size_t r = 0; r < 4; ++r)
+                {
+                    __m256i const v = _mm256_loadu_si256(reinterpret_cast<__m256i const*>(block + 2 * r));
+                    uint32_t const halves = _mm256_movemask_pd(_mm256_castsi256_pd(_mm256_cmpeq_epi64(v, n)));
+                    mask |= (halves & (halves >> 1) & 0x5) << (4 * r);
+                }
+
+                return mask;
+            }
+        };
+#endif
+
+        /**
+         * Compares one uuid at a time, with SSE2 when UUID_LIB_USE_SIMD is enabled (see uuid::operator==).
+         */
+        struct block_matcher_baseline
+        {
+            uint32_t operator()(uuid const* block, uuid const& needle) const noexcept
+            {
+                uint32_t mask = 0;
+                for (size_t i = 0; i < s_search_block_size; ++i)
+                {
+                    mask |= static_cast<uint32_t>(block[i] == needle) << (2 * i);
+                }
+
+                return mask;
+            }
+        };
+
+        // The search loops are forced inline into the per-instruction-set entry points below, so that the block
+        // matcher is inlined into a function compiled for the same instruction set
+
+        template<typename matcher_t>
+        UUID_LIB_ALWAYS_INLINE size_t index_of_impl(std::span<uuid const> haystack, uuid const& needle, matcher_t const& match) noexcept
+        {
+            size_t i = 0;
+            for (; i + s_search_block_size <= haystack.size(); i += s_search_block_size)
+            {
+                if (uint32_t const mask = match(haystack.data() + i, needle); mask != 0)
+                {
+                    return i + std::countr_zero(mask) / 2;
+                }
+            }
+
+            for (; i < haystack.size(); ++i)
+            {
+                if (haystack[i] == needle)
+                {
+                    return i;
+                }
+            }
+
+            return haystack.size();
+        }
+
+        template<typename matcher_t>
+        UUID_LIB_ALWAYS_INLINE void index_of_many_impl(std::span<uuid const> haystack, std::span<uuid const> needles, std::span<size_t> out_indices, matcher_t const& match) noexcept
+        {
+            std::fill_n(out_indices.begin(), needles.size(), haystack.size());
+            size_t num_remaining = needles.size();
+
+            // Each block of the haystack is loaded from memory once and then compared against every needle from cache
+            size_t i = 0;
+            for (; i + s_search_block_size <= haystack.size() and num_remaining > 0; i += s_search_block_size)
+            {
+                for (size_t k = 0; k < needles.size(); ++k)
+                {
+                    uint32_t const mask = match(haystack.data() + i, needles[k]);
+                    if (mask != 0 and out_indices[k] == haystack.size())
+                    {
+                        out_indices[k] = i + std::countr_zero(mask) / 2;
+                        --num_remaining;
+                    }
+                }
+            }
+
+            for (; i < haystack.size() and num_remaining > 0; ++i)
+            {
+                for (size_t k = 0; k < needles.size(); ++k)
+                {
+                    if (haystack[i] == needles[k] and out_indices[k] == haystack.size())
+                    {
+                        out_indices[k] = i;
+                        --num_remaining;
+                    }
+                }
+            }
+        }
+
+        template<typename matcher_t>
+        UUID_LIB_ALWAYS_INLINE size_t count_impl(std::span<uuid const> haystack, uuid const& needle, matcher_t const& match) noexcept
+        {
+            size_t count = 0;
+            size_t i = 0;
+            for (; i + s_search_block_size <= haystack.size(); i += s_search_block_size)
+            {
+                count += std::popcount(match(haystack.data() + i, needle));
+            }
+
+            for (; i < haystack.size(); ++i)
+            {
+                count += haystack[i] == needle;
+            }
+
+            return count;
+        }
+
+#ifdef UUID_LIB_USE_SIMD
+        UUID_LIB_TARGET("avx512f") inline size_t index_of_avx512(std::span<uuid const> haystack, uuid const& needle) noexcept
+        {
+            return index_of_impl(haystack, needle, block_matcher_avx512{});
+        }
+
+        UUID_LIB_TARGET("avx2") inline size_t index_of_avx2(std::span<uuid const> haystack, uuid const& needle) noexcept
+        {
+            return index_of_impl(haystack, needle, block_matcher_avx2{});
+        }
+
+        UUID_LIB_TARGET("avx512f") inline void index_of_many_avx512(std::span<uuid const> haystack, std::span<uuid const> needles, std::span<size_t> out_indices) noexcept
+        {
+            index_of_many_impl(haystack, needles, out_indices, block_matcher_avx512{});
+        }
+
+        UUID_LIB_TARGET("avx2") inline void index_of_many_avx2(std::span<uuid const> haystack, std::span<uuid const> needles, std::span<size_t> out_indices) noexcept
+        {
+            index_of_many_impl(haystack, needles, out_indices, block_matcher_avx2{});
+        }
+
+        UUID_LIB_TARGET("avx512f") inline size_t count_avx512(std::span<uuid const> haystack, uuid const& needle) noexcept
+        {
+            return count_impl(haystack, needle, block_matcher_avx512{});
+        }
+
+        UUID_LIB_TARGET("avx2") inline size_t count_avx2(std::span<uuid const> haystack, uuid const& needle) noexcept
+        {
+            return count_impl(haystack, needle, block_matcher_avx2{});
+        }
+#endif
+    }
+
+    inline size_t uuid_index_of(std::span<uuid const> haystack, uuid const& needle) noexcept
+    {
+#ifdef UUID_LIB_USE_SIMD
+        if (detail::has_avx512f())
+        {
+            return detail::index_of_avx512(haystack, needle);
+        }
+
+        if (detail::has_avx2())
+        {
+            return detail::index_of_avx2(haystack, needle);
+        }
+#endif
+        return detail::index_of_impl(haystack, needle, detail::block_matcher_baseline{});
+    }
+
+    inline void uuid_index_of(std::span<uuid const> haystack, std::span<uuid const> needles, std::span<size_t> out_indices) noexcept
+    {
+#ifdef UUID_LIB_USE_SIMD
+        if (detail::has_avx512f())
+        {
+            detail::index_of_many_avx512(haystack, needles, out_indices);
+            return;
+        }
+
+        if (detail::has_avx2())
+        {
+            detail::index_of_many_avx2(haystack, needles, out_indices);
+            return;
+        }
+#endif
+        detail::index_of_many_impl(haystack, needles, out_indices, detail::block_matcher_baseline{});
+    }
+
+    inline std::span<uuid const>::iterator uuid_find(std::span<uuid const> haystack, uuid const& needle) noexcept
+    {
+        return haystack.begin() + static_cast<ptrdiff_t>(uuid_index_of(haystack, needle));
+    }
+
+    inline bool uuid_contains(std::span<uuid const> haystack, uuid const& needle) noexcept
+    {
+        return uuid_index_of(haystack, needle) != haystack.size();
+    }
+
+    inline size_t uuid_count(std::span<uuid const> haystack, uuid const& needle) noexcept
+    {
+#ifdef UUID_LIB_USE_SIMD
+        if (detail::has_avx512f())
+        {
+            return detail::count_avx512(haystack, needle);
+        }
+
+        if (detail::has_avx2())
+        {
+            return detail::count_avx2(haystack, needle);
+        }
+#endif
+        return detail::count_impl(haystack, needle, detail::block_matcher_baseline{});
+    }
+}
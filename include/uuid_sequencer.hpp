@@ -0,0 +1,67 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+
+#include "uuid_clock.hpp"
+
+namespace LambdaSnail::Uuid
+{
+    /**
+     * Hands out strictly increasing v7 ticks (a millisecond timestamp and a 12-bit rand_a, see detail::to_v7_tick)
+     * to any number of threads without locks. Together with uuid_factory::create_uuid_v7(sequencer, id), this gives
+     * one ordered sequence of v7 uuids shared by every thread that uses the sequencer.
+     *
+     * The last tick handed out is kept in a single 64-bit atomic. While the clock is ahead of it, a claim moves it to
+     * the current time with a compare-and-swap. Otherwise the clock is not ahead (many claims within one 1/4096 ms step,
+     * or the clock went backwards), and the claim takes the next ticks with a fetch_add, which always succeeds. The
+     * timestamp then runs ahead of the clock until the clock catches up.
+     *
+     * @tparam clock_policy_t The clock to read, which must allow concurrent calls to now().
+     */
+    template<shared_uuid_clock clock_policy_t = system_clock_policy>
+    class v7_sequencer
+    {
+    public:
+        /**
+         * Claims a block of consecutive ticks, with one atomic operation in the common case.
+         * @param count The number of ticks to claim. Must be at least one.
+         * @return The first tick of the block. The block is first, first + 1, ..., first + count - 1.
+         */
+        [[nodiscard]] uint64_t claim(uint64_t count = 1) noexcept
+        {
+            uint64_t const now = detail::to_v7_tick(m_clock.now());
+            uint64_t last = m_last_tick.load(std::memory_order_relaxed);
+
+            while (now > last)
+            {
+                // On failure, last is reloaded and the clock check is repeated against it
+                if (m_last_tick.compare_exchange_weak(last, now + count - 1, std::memory_order_relaxed))
+                {
+                    return now;
+                }
+            }
+
+            return m_last_tick.fetch_add(count, std::memory_order_relaxed) + 1;
+        }
+
+        /**
+         * Returns the last tick handed out, or zero if there has been none.
+         */
+        [[nodiscard]] uint64_t last() const noexcept
+        {
+            return m_last_tick.load(std::memory_order_relaxed);
+        }
+
+        /**
+         * Returns the clock the sequencer reads.
+         */
+        [[nodiscard]] clock_policy_t& get_clock() noexcept { return m_clock; }
+
+    private:
+        clock_policy_t m_clock;
+
+        // On its own cache line, since every claiming thread writes it
+        alignas(64) std::atomic<uint64_t> m_last_tick = 0;
+    };
+}
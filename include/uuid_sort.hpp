@@ -0,0 +1,290 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cstdint>
+#include <memory>
+#include <numeric>
+#include <span>
+#include <thread>
+#include <vector>
+
+#include "uuid.hpp"
+
+namespace LambdaSnail::Uuid
+{
+    /**
+     * Sorts uuids in ascending order (the order of operator<=>) with an MSD radix sort over the 16 octets.
+     *
+     * Before each pass the sort finds the octets that actually vary within the current range, and skips the ones that
+     * do not. For v7 uuids this skips the leading timestamp octets shared by the whole range. Ranges that are already
+     * sorted, such as runs of v7 uuids created in order, are detected and left alone. Small ranges fall back to
+     * std::sort.
+     *
+     * This allocates a scratch buffer of the same size as the input.
+     *
+     * @param ids The uuids to sort.
+     */
+    void uuid_sort(std::span<uuid> ids);
+
+    /**
+     * Sorts uuids in ascending order like uuid_sort, but splits the work over several threads. The first radix pass is
+     * done with one chunk of the input per thread, after which the buckets are shared out between the threads.
+     *
+     * @param ids The uuids to sort.
+     * @param num_threads The number of threads to use, including the calling thread.
+     */
+    void uuid_sort_parallel(std::span<uuid> ids, size_t num_threads = std::thread::hardware_concurrency());
+
+    namespace detail
+    {
+        /**
+         * Ranges of at most this size are sorted with std::sort instead of another radix pass.
+         */
+        inline constexpr size_t s_radix_sort_threshold = 64;
+
+        /**
+         * Inputs smaller than this are not worth spreading over several threads.
+         */
+        inline constexpr size_t s_parallel_sort_threshold = 1 << 16;
+
+        using radix_counts_t = std::array<size_t, 256>;
+
+        /**
+         * Uninitialized storage for uuids, which is only ever written before it is read.
+         */
+        struct uuid_scratch_buffer
+        {
+            explicit uuid_scratch_buffer(size_t size) : data(std::allocator<uuid>().allocate(size)), size(size) {}
+            uuid_scratch_buffer(uuid_scratch_buffer const&) = delete;
+            ~uuid_scratch_buffer() { std::allocator<uuid>().deallocate(data, size); }
+
+            uuid* data;
+            size_t size;
+        };
+
+        /**
+         * Returns a bit mask of the octets that are not the same for all the uuids, bit i standing for octet i.
+         * @param reference Any uuid from the range the mask should be computed for.
+         */
+        inline uint32_t varying_octets(std::span<uuid const> ids, uuid const& reference) noexcept
+        {
+#ifdef UUID_LIB_USE_SIMD
+            __m128i const first = _mm_load_si128(reinterpret_cast<__m128i const*>(reference.octets.data()));
+            __m128i diff = _mm_setzero_si128();
+
+            for (uuid const& id : ids)
+            {
+                diff = _mm_or_si128(diff, _mm_xor_si128(first, _mm_load_si128(reinterpret_cast<__m128i const*>(id.octets.data()))));
+            }
+
+            return ~static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(diff, _mm_setzero_si128()))) & 0xFFFF;
+#else
+            uint64_t first_lo, first_hi;
+            memcpy(&first_lo, reference.octets.data(), sizeof(uint64_t));
+            memcpy(&first_hi, reference.octets.data() + 8, sizeof(uint64_t));
+
+            uint64_t diff_lo = 0, diff_hi = 0;
+            for (uuid const& id : ids)
+            {
+                uint64_t lo, hi;
+                memcpy(&lo, id.octets.data(), sizeof(uint64_t));
+                memcpy(&hi, id.octets.data() + 8, sizeof(uint64_t));
+
+                diff_lo |= lo ^ first_lo;
+                diff_hi |= hi ^ first_hi;
+            }
+
+            std::array<uint8_t, 16> diff;
+            memcpy(diff.data(), &diff_lo, sizeof(uint64_t));
+            memcpy(diff.data() + 8, &diff_hi, sizeof(uint64_t));
+
+            uint32_t mask = 0;
+            for (size_t i = 0; i < 16; ++i)
+            {
+                mask |= static_cast<uint32_t>(diff[i] != 0) << i;
+            }
+
+            return mask;
+#endif
+        }
+
+        /**
+         * Returns the first octet at or after the given one that varies in the range, or 16 if there is none.
+         */
+        inline size_t first_varying_octet(uint32_t varying, size_t octet) noexcept
+        {
+            uint32_t const remaining = varying & (0xFFFFu << octet);
+            return remaining == 0 ? 16 : std::countr_zero(remaining);
+        }
+
+        inline void count_octet(std::span<uuid const> ids, size_t octet, radix_counts_t& counts) noexcept
+        {
+            for (uuid const& id : ids)
+            {
+                ++counts[id.octets[octet]];
+            }
+        }
+
+        /**
+         * Sorts the range on the given octet and the ones after it. The scratch buffer must be as large as the range.
+         */
+        inline void radix_sort_msd(std::span<uuid> ids, uuid* scratch, size_t octet)
+        {
+            if (ids.size() <= s_radix_sort_threshold)
+            {
+                std::sort(ids.begin(), ids.end());
+                return;
+            }
+
+            if (std::is_sorted(ids.begin(), ids.end()))
+            {
+                return;
+            }
+
+            octet = first_varying_octet(varying_octets(ids, ids[0]), octet);
+            if (octet == 16)
+            {
+                return;
+            }
+
+            radix_counts_t counts{};
+            count_octet(ids, octet, counts);
+
+            radix_counts_t offsets;
+            std::exclusive_scan(counts.begin(), counts.end(), offsets.begin(), size_t{0});
+
+            radix_counts_t next = offsets;
+            for (uuid const& id : ids)
+            {
+                scratch[next[id.octets[octet]]++] = id;
+            }
+
+            std::copy_n(scratch, ids.size(), ids.begin());
+
+            for (size_t bucket = 0; bucket < counts.size(); ++bucket)
+            {
+                if (counts[bucket] > 1)
+                {
+                    radix_sort_msd(ids.subspan(offsets[bucket], counts[bucket]), scratch + offsets[bucket], octet + 1);
+                }
+            }
+        }
+
+        /**
+         * Runs the function once per thread index, on num_threads - 1 new threads and the calling thread.
+         */
+        template<typename function_t>
+        void run_on_threads(size_t num_threads, function_t const& function)
+        {
+            std::vector<std::jthread> threads;
+            threads.reserve(num_threads - 1);
+
+            for (size_t t = 1; t < num_threads; ++t)
+            {
+                threads.emplace_back(function, t);
+            }
+
+            function(0);
+        }
+    }
+
+    inline void uuid_sort(std::span<uuid> ids)
+    {
+        if (ids.size() <= detail::s_radix_sort_threshold)
+        {
+            std::sort(ids.begin(), ids.end());
+            return;
+        }
+
+        if (std::is_sorted(ids.begin(), ids.end()))
+        {
+            return;
+        }
+
+        detail::uuid_scratch_buffer scratch(ids.size());
+        detail::radix_sort_msd(ids, scratch.data, 0);
+    }
+
+    inline void uuid_sort_parallel(std::span<uuid> ids, size_t num_threads)
+    {
+        if (num_threads <= 1 or ids.size() < detail::s_parallel_sort_threshold)
+        {
+            uuid_sort(ids);
+            return;
+        }
+
+        if (std::is_sorted(ids.begin(), ids.end()))
+        {
+            return;
+        }
+
+        size_t const chunk_size = (ids.size() + num_threads - 1) / num_threads;
+        auto const chunk = [&](size_t t)
+        {
+            size_t const begin = std::min(t * chunk_size, ids.size());
+            size_t const end = std::min(begin + chunk_size, ids.size());
+            return ids.subspan(begin, end - begin);
+        };
+
+        // Find the first octet that varies across the whole input
+        std::vector<uint32_t> varying(num_threads);
+        detail::run_on_threads(num_threads, [&](size_t t) { varying[t] = detail::varying_octets(chunk(t), ids[0]); });
+
+        size_t const octet = detail::first_varying_octet(std::accumulate(varying.begin(), varying.end(), 0u, std::bit_or<>()), 0);
+        if (octet == 16)
+        {
+            return;
+        }
+
+        // Each thread scatters its own chunk, into the part of each bucket that follows the chunks before it
+        std::vector<detail::radix_counts_t> counts(num_threads, detail::radix_counts_t{});
+        detail::run_on_threads(num_threads, [&](size_t t) { detail::count_octet(chunk(t), octet, counts[t]); });
+
+        detail::radix_counts_t bucket_offsets{};
+        detail::radix_counts_t bucket_sizes{};
+        std::vector<detail::radix_counts_t> thread_offsets(num_threads);
+
+        size_t offset = 0;
+        for (size_t bucket = 0; bucket < bucket_offsets.size(); ++bucket)
+        {
+            bucket_offsets[bucket] = offset;
+            for (size_t t = 0; t < num_threads; ++t)
+            {
+                thread_offsets[t][bucket] = offset;
+                offset += counts[t][bucket];
+            }
+
+            bucket_sizes[bucket] = offset - bucket_offsets[bucket];
+        }
+
+        detail::uuid_scratch_buffer scratch(ids.size());
+        detail::run_on_threads(num_threads, [&](size_t t)
+        {
+            detail::radix_counts_t& next = thread_offsets[t];
+            for (uuid const& id : chunk(t))
+            {
+                scratch.data[next[id.octets[octet]]++] = id;
+            }
+        });
+
+        // The buckets are independent, so the threads take them one at a time until all are sorted
+        std::atomic<size_t> next_bucket = 0;
+        detail::run_on_threads(num_threads, [&](size_t)
+        {
+            for (size_t bucket = next_bucket++; bucket < bucket_sizes.size(); bucket = next_bucket++)
+            {
+                std::span<uuid> const target = ids.subspan(bucket_offsets[bucket], bucket_sizes[bucket]);
+                uuid* const source = scratch.data + bucket_offsets[bucket];
+
+                std::copy_n(source, target.size(), target.begin());
+                if (target.size() > 1)
+                {
+                    detail::radix_sort_msd(target, source, octet + 1);
+                }
+            }
+        });
+    }
+}
@@ -0,0 +1,129 @@
+#pragma once
+
+#include <cstdint>
+#include <type_traits>
+
+#include "uuid.hpp"
+
+namespace LambdaSnail::Uuid
+{
+    /**
+     * A range of bits in a uuid. Bits are numbered from the most significant bit of octet 0, as in the RFC, so a
+     * field at offset 0 with width 48 covers the same bits as the timestamp of v7.
+     */
+    struct v8_field
+    {
+        uint8_t offset = 0;
+        uint8_t width = 0;
+    };
+
+    /**
+     * The layout of a version eight uuid with a timestamp and a shard (or node) id in fixed bit ranges. The other bits
+     * that are not version or variant bits are random. Since the shard id is always in the same place, a router can
+     * read it straight from the octets with shard(), which is a load, a shift and a mask.
+     *
+     * The timestamp is the Unix time in milliseconds, truncated to the width of its field. With the field at offset 0,
+     * uuids sort by time first, like v7.
+     *
+     * Each field must be within one 64-bit half of the uuid and must not overlap the other field, the version bits
+     * (48-51) or the variant bits (64-65). A field may have width 0 if it is not needed.
+     *
+     * @tparam time_field The bits of the timestamp.
+     * @tparam shard_field The bits of the shard id.
+     */
+    template<v8_field time_field = v8_field{ 0, 48 }, v8_field shard_field = v8_field{ 52, 12 }>
+    struct v8_layout
+    {
+        static inline constexpr v8_field time = time_field;
+        static inline constexpr v8_field shard_id = shard_field;
+
+        /**
+         * Returns the shard id of a uuid created with this layout.
+         */
+        [[nodiscard]] static constexpr uint64_t shard(uuid const& id) noexcept { return get(id.octets, shard_field); }
+
+        /**
+         * Returns the timestamp of a uuid created with this layout, in milliseconds truncated to the field width.
+         */
+        [[nodiscard]] static constexpr uint64_t timestamp_ms(uuid const& id) noexcept { return get(id.octets, time_field); }
+
+        // The masks of the fields, version and variant within the upper (octets 0-7) and lower (octets 8-15) halves
+
+        static inline constexpr uint64_t s_version_mask = static_cast<uint64_t>(0xF) << 12;
+        static inline constexpr uint64_t s_version_bits = static_cast<uint64_t>(0x8) << 12;
+        static inline constexpr uint64_t s_variant_mask = static_cast<uint64_t>(0b11) << 62;
+        static inline constexpr uint64_t s_variant_bits = static_cast<uint64_t>(0b10) << 62;
+
+        /**
+         * Returns the mask of a field within its half, or zero if it is in the other half.
+         */
+        [[nodiscard]] static constexpr uint64_t mask(v8_field field, bool upper) noexcept
+        {
+            if (field.width == 0 or (field.offset < 64) != upper)
+            {
+                return 0;
+            }
+
+            return value_mask(field) << shift(field);
+        }
+
+        /**
+         * Returns the number of bits a field value is shifted left by within its half.
+         */
+        [[nodiscard]] static constexpr uint32_t shift(v8_field field) noexcept
+        {
+            return 64 - field.offset % 64 - field.width;
+        }
+
+        [[nodiscard]] static constexpr uint64_t value_mask(v8_field field) noexcept
+        {
+            return field.width == 64 ? ~static_cast<uint64_t>(0) : (static_cast<uint64_t>(1) << field.width) - 1;
+        }
+
+        /**
+         * The bits of each half that are filled with random data.
+         */
+        static inline constexpr uint64_t s_random_upper = ~(mask(time_field, true) | mask(shard_field, true) | s_version_mask);
+        static inline constexpr uint64_t s_random_lower = ~(mask(time_field, false) | mask(shard_field, false) | s_variant_mask);
+
+    private:
+        [[nodiscard]] static constexpr uint64_t get(uuid::octet_set_t const& octets, v8_field field) noexcept
+        {
+            if (field.width == 0)
+            {
+                return 0;
+            }
+
+            size_t const first = field.offset < 64 ? 0 : 8;
+            uint64_t half = 0;
+            if (std::is_constant_evaluated())
+            {
+                for (size_t i = 0; i < 8; ++i)
+                {
+                    half = half << 8 | octets[first + i];
+                }
+            }
+            else
+            {
+                half = detail::load_big_endian(octets.data() + first);
+            }
+
+            return half >> shift(field) & value_mask(field);
+        }
+
+        static constexpr bool within_one_half(v8_field field) noexcept
+        {
+            return field.width == 0 or (field.offset + field.width <= 128 and field.offset / 64 == (field.offset + field.width - 1) / 64);
+        }
+
+        static constexpr bool overlaps(v8_field a, v8_field b) noexcept
+        {
+            return a.width > 0 and b.width > 0 and a.offset < b.offset + b.width and b.offset < a.offset + a.width;
+        }
+
+        static_assert(within_one_half(time_field) and within_one_half(shard_field), "A v8 field must not cross octet 7 to octet 8");
+        static_assert(not overlaps(time_field, shard_field), "The v8 fields must not overlap");
+        static_assert(not overlaps(time_field, v8_field{ 48, 4 }) and not overlaps(shard_field, v8_field{ 48, 4 }), "A v8 field must not overlap the version bits");
+        static_assert(not overlaps(time_field, v8_field{ 64, 2 }) and not overlaps(shard_field, v8_field{ 64, 2 }), "A v8 field must not overlap the variant bits");
+    };
+}
@@ -0,0 +1,102 @@
+#pragma once
+
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <ranges>
+#include <span>
+
+#include "uuid.hpp"
+
+namespace LambdaSnail::Uuid
+{
+    namespace detail
+    {
+        /**
+         * Fills a span by calling a batch member function of a factory. Unlike a lambda, this can be assigned, which
+         * std::ranges::view requires.
+         */
+        template<typename factory_t, void (factory_t::*fill)(std::span<uuid>) noexcept>
+        struct factory_fill
+        {
+            factory_t* factory;
+
+            void operator()(std::span<uuid> out_ids) const noexcept { (factory->*fill)(out_ids); }
+        };
+    }
+
+    /**
+     * An infinite, single-pass range of uuids. The uuids are created a block at a time into a buffer owned by the
+     * view, so the per-batch costs (reading the clock, setting up the generators) are shared by the whole block even
+     * when the uuids are consumed one by one. A new block is created when the previous one is used up.
+     *
+     * The view can be moved but not copied, since the buffer holds uuids that must only be handed out once.
+     *
+     * @tparam fill_t A callable that fills a std::span<uuid> with new uuids.
+     * @tparam block_size The number of uuids created at a time.
+     */
+    template<typename fill_t, size_t block_size = 256>
+    class uuid_block_view : public std::ranges::view_interface<uuid_block_view<fill_t, block_size>>
+    {
+    public:
+        class iterator
+        {
+        public:
+            using value_type = uuid;
+            using difference_type = std::ptrdiff_t;
+            using iterator_concept = std::input_iterator_tag;
+
+            iterator() = default;
+            explicit iterator(uuid_block_view* view) noexcept : m_view(view) {}
+
+            uuid const& operator*() const noexcept { return m_view->m_buffer[m_view->m_position]; }
+
+            iterator& operator++() noexcept
+            {
+                if (++m_view->m_position == block_size)
+                {
+                    m_view->refill();
+                }
+
+                return *this;
+            }
+
+            void operator++(int) noexcept { ++*this; }
+
+        private:
+            uuid_block_view* m_view = nullptr;
+        };
+
+        explicit uuid_block_view(fill_t fill) : m_fill(std::move(fill)), m_buffer(std::make_unique<uuid[]>(block_size)) {}
+
+        uuid_block_view(uuid_block_view&&) noexcept = default;
+        uuid_block_view& operator=(uuid_block_view&&) noexcept = default;
+
+        /**
+         * Creates the first block if it has not been created yet. Like other input ranges, the view should only be
+         * iterated once: uuids that were handed out before are not repeated.
+         */
+        [[nodiscard]] iterator begin()
+        {
+            if (m_position == block_size)
+            {
+                refill();
+            }
+
+            return iterator(this);
+        }
+
+        [[nodiscard]] std::unreachable_sentinel_t end() const noexcept { return std::unreachable_sentinel; }
+
+    private:
+        fill_t m_fill;
+        std::unique_ptr<uuid[]> m_buffer;
+        size_t m_position = block_size;
+
+        void refill() noexcept
+        {
+            m_fill(std::span<uuid, block_size>(m_buffer.get(), block_size));
+            m_position = 0;
+        }
+    };
+}
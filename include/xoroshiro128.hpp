@@ -0,0 +1,325 @@
+#pragma once
+
+/*  Written in 2019 by David Blackman and Sebastiano Vigna (vigna@acm.org)
+
+To the extent possible under law, the author has dedicated all copyright
+and related and neighboring rights to this software to the public domain
+worldwide. This software is distributed without any warranty.
+
+See <http://creativecommons.org/publicdomain/zero/1.0/>. */
+
+#include <array>
+#include <bit>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+
+#include "uuid_cpu.hpp"
+
+/*
+ * Retrieved from https://xoroshiro.di.unimi.it/xoroshiro128plusplus.c
+ * Minor adaptions by Niclas Blomberg
+ *
+ * This is xoroshiro128++ 1.0, one of our all-purpose, rock-solid,
+ * small-state generators. It is extremely (sub-ns) fast and it passes all
+ * tests we are aware of, but its state space is large enough only for
+ * mild parallelism.
+ *
+ * For generating just floating-point numbers, xoroshiro128+ is even
+ * faster (but it has a very mild bias, see notes in the comments).
+ *
+ * The state must be seeded so that it is not everywhere zero. If you have
+ * a 64-bit seed, we suggest to seed a splitmix64 generator and use its
+ * output to fill s.
+ */
+
+namespace LambdaSnail::Uuid
+{
+    class xoroshiro128pp
+    {
+    public:
+        /*
+         * Seeds the state with the current system time stamp.
+         */
+        xoroshiro128pp();
+        xoroshiro128pp(xoroshiro128pp const& xoroshiro128_pp) = delete;
+
+        void seed_state(std::array<uint64_t, 2> const&& state);
+
+        uint64_t next();
+        uint64_t operator()();
+
+        /*
+         * This is the jump function for the generator. It is equivalent
+         * to 2^64 calls to next(); it can be used to generate 2^64
+         * non-overlapping subsequences for parallel computations.
+         */
+        void jump();
+
+        /*
+         * This is the long-jump function for the generator. It is equivalent to
+         * 2^96 calls to next(); it can be used to generate 2^32 starting points,
+         * from each of which jump() will generate 2^32 non-overlapping
+         * subsequences for parallel distributed computations.
+         */
+        void long_jump();
+
+        [[nodiscard]] std::array<uint64_t, 2> const& get_state() const noexcept { return s; }
+
+    private:
+
+        std::array<uint64_t, 2> s = {};
+
+        [[nodiscard]]
+        static inline auto rotl(const uint64_t x, int const k) -> uint64_t
+        {
+            return (x << k) | (x >> (64 - k));
+        }
+    };
+
+    inline xoroshiro128pp::xoroshiro128pp()
+    {
+        using namespace std::chrono;
+        uint64_t const s1 = system_clock::now().time_since_epoch().count();
+        uint64_t const s2 = system_clock::now().time_since_epoch().count();
+
+        seed_state({ s1, s2 });
+    }
+
+    inline void xoroshiro128pp::seed_state(std::array<uint64_t, 2> const &&state)
+    {
+        s[0] = state[0];
+        s[1] = state[1];
+    }
+
+    inline uint64_t xoroshiro128pp::next()
+    {
+        const uint64_t s0 = s[0];
+        uint64_t s1 = s[1];
+        const uint64_t result = rotl(s0 + s1, 17) + s0;
+
+        s1 ^= s0;
+        s[0] = rotl(s0, 49) ^ s1 ^ (s1 << 21); // a, b
+        s[1] = rotl(s1, 28); // c
+
+        return result;
+    }
+
+    inline uint64_t xoroshiro128pp::operator()()
+    {
+        return next();
+    }
+
+    inline void xoroshiro128pp::jump()
+    {
+        static constexpr std::array<uint64_t, 2> jump = { 0x2bd7a6a6e99c2ddc, 0x0992ccaf6a6fca05 };
+
+        uint64_t s0 = 0;
+        uint64_t s1 = 0;
+        for(size_t i = 0; i < jump.size(); i++)
+        {
+            for(int b = 0; b < 64; b++) {
+                if (jump[i] & static_cast<uint64_t>(1) << b) {
+                    s0 ^= s[0];
+                    s1 ^= s[1];
+                }
+                next();
+            }
+        }
+
+        s[0] = s0;
+        s[1] = s1;
+    }
+
+    inline void xoroshiro128pp::long_jump()
+    {
+        static constexpr std::array<uint64_t, 2> long_jump = { 0x360fd5f2cf8d5d99, 0x9c6e6877736c46e3 };
+
+        uint64_t s0 = 0;
+        uint64_t s1 = 0;
+        for(size_t i = 0; i < long_jump.size(); i++)
+        {
+            for(int b = 0; b < 64; b++) {
+                if (long_jump[i] & static_cast<uint64_t>(1) << b) {
+                    s0 ^= s[0];
+                    s1 ^= s[1];
+                }
+                next();
+            }
+        }
+
+        s[0] = s0;
+        s[1] = s1;
+    }
+
+    /**
+     * Eight xoroshiro128++ generators stepped side by side, so that one step is a single pass over 512-bit (AVX-512)
+     * or 256-bit (AVX2) registers. The lanes are seeded from one generator, each jump() further than the last, so their
+     * streams do not overlap.
+     *
+     * The output is made up of 128-bit blocks, each filled with the next outputs of two neighbouring lanes. Every block
+     * is masked on the way out, which lets callers set fixed bits (such as uuid version bits) in the same pass.
+     */
+    class xoroshiro128pp_x8
+    {
+    public:
+        static inline constexpr size_t s_num_lanes = 8;
+        static inline constexpr size_t s_blocks_per_step = s_num_lanes / 2;
+
+        /**
+         * Seeds lane i with the state of the generator advanced by i jumps. The generator itself is not changed.
+         */
+        void seed(xoroshiro128pp const& generator) noexcept;
+
+        /**
+         * Writes num_blocks 128-bit blocks to out, each computed as (random & and_mask) | or_mask. The masks are given
+         * as the 16 bytes of a block in memory order.
+         */
+        void fill(void* out, size_t num_blocks, std::array<uint8_t, 16> const& and_mask, std::array<uint8_t, 16> const& or_mask) noexcept;
+
+    private:
+        // Struct of arrays, so that a register holds the same half of the state for consecutive lanes
+        alignas(64) std::array<uint64_t, s_num_lanes> s0 = {};
+        alignas(64) std::array<uint64_t, s_num_lanes> s1 = {};
+
+        /**
+         * Advances every lane by one step and writes the masked output of all lanes.
+         */
+        void step_scalar(uint64_t* out, std::array<uint64_t, 2> const& and_mask, std::array<uint64_t, 2> const& or_mask) noexcept;
+
+#ifdef UUID_LIB_USE_SIMD
+        UUID_LIB_TARGET("avx2") size_t fill_avx2(uint8_t* out, size_t num_steps, std::array<uint64_t, 2> const& and_mask, std::array<uint64_t, 2> const& or_mask) noexcept;
+        UUID_LIB_TARGET("avx512f") size_t fill_avx512(uint8_t* out, size_t num_steps, std::array<uint64_t, 2> const& and_mask, std::array<uint64_t, 2> const& or_mask) noexcept;
+#endif
+    };
+
+    inline void xoroshiro128pp_x8::seed(xoroshiro128pp const& generator) noexcept
+    {
+        xoroshiro128pp lane;
+        lane.seed_state({ generator.get_state()[0], generator.get_state()[1] });
+
+        for (size_t i = 0; i < s_num_lanes; ++i)
+        {
+            s0[i] = lane.get_state()[0];
+            s1[i] = lane.get_state()[1];
+            lane.jump();
+        }
+    }
+
+    inline void xoroshiro128pp_x8::step_scalar(uint64_t* out, std::array<uint64_t, 2> const& and_mask, std::array<uint64_t, 2> const& or_mask) noexcept
+    {
+        for (size_t i = 0; i < s_num_lanes; ++i)
+        {
+            uint64_t const a = s0[i];
+            uint64_t b = s1[i];
+            out[i] = ((std::rotl(a + b, 17) + a) & and_mask[i % 2]) | or_mask[i % 2];
+
+            b ^= a;
+            s0[i] = std::rotl(a, 49) ^ b ^ (b << 21);
+            s1[i] = std::rotl(b, 28);
+        }
+    }
+
+#ifdef UUID_LIB_USE_SIMD
+    namespace detail
+    {
+        UUID_LIB_TARGET("avx2") inline __m256i rotl_avx2(__m256i x, int k) noexcept
+        {
+            return _mm256_or_si256(_mm256_slli_epi64(x, k), _mm256_srli_epi64(x, 64 - k));
+        }
+    }
+
+    inline size_t xoroshiro128pp_x8::fill_avx2(uint8_t* out, size_t num_steps, std::array<uint64_t, 2> const& and_mask, std::array<uint64_t, 2> const& or_mask) noexcept
+    {
+        __m256i const and_v = _mm256_setr_epi64x(and_mask[0], and_mask[1], and_mask[0], and_mask[1]);
+        __m256i const or_v = _mm256_setr_epi64x(or_mask[0], or_mask[1], or_mask[0], or_mask[1]);
+
+        // Lanes 0-3 and 4-7
+        __m256i a[2] = { _mm256_load_si256(reinterpret_cast<__m256i const*>(s0.data())), _mm256_load_si256(reinterpret_cast<__m256i const*>(s0.data() + 4)) };
+        __m256i b[2] = { _mm256_load_si256(reinterpret_cast<__m256i const*>(s1.data())), _mm256_load_si256(reinterpret_cast<__m256i const*>(s1.data() + 4)) };
+
+        for (size_t step = 0; step < num_steps; ++step)
+        {
+            for (size_t r = 0; r < 2; ++r)
+            {
+                __m256i const result = _mm256_add_epi64(detail::rotl_avx2(_mm256_add_epi64(a[r], b[r]), 17), a[r]);
+                _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + 32 * r), _mm256_or_si256(_mm256_and_si256(result, and_v), or_v));
+
+                b[r] = _mm256_xor_si256(b[r], a[r]);
+                a[r] = _mm256_xor_si256(_mm256_xor_si256(detail::rotl_avx2(a[r], 49), b[r]), _mm256_slli_epi64(b[r], 21));
+                b[r] = detail::rotl_avx2(b[r], 28);
+            }
+
+            out += 64;
+        }
+
+        _mm256_store_si256(reinterpret_cast<__m256i*>(s0.data()), a[0]);
+        _mm256_store_si256(reinterpret_cast<__m256i*>(s0.data() + 4), a[1]);
+        _mm256_store_si256(reinterpret_cast<__m256i*>(s1.data()), b[0]);
+        _mm256_store_si256(reinterpret_cast<__m256i*>(s1.data() + 4), b[1]);
+        return num_steps;
+    }
+
+    inline size_t xoroshiro128pp_x8::fill_avx512(uint8_t* out, size_t num_steps, std::array<uint64_t, 2> const& and_mask, std::array<uint64_t, 2> const& or_mask) noexcept
+    {
+        __m512i const and_v = _mm512_set_epi64(and_mask[1], and_mask[0], and_mask[1], and_mask[0], and_mask[1], and_mask[0], and_mask[1], and_mask[0]);
+        __m512i const or_v = _mm512_set_epi64(or_mask[1], or_mask[0], or_mask[1], or_mask[0], or_mask[1], or_mask[0], or_mask[1], or_mask[0]);
+
+        __m512i a = _mm512_load_si512(s0.data());
+        __m512i b = _mm512_load_si512(s1.data());
+
+        for (size_t step = 0; step < num_steps; ++step)
+        {
+            // The AND and OR are done with a single ternary logic instruction: (result & and_v) | or_v
+            __m512i const result = _mm512_add_epi64(_mm512_rol_epi64(_mm512_add_epi64(a, b), 17), a);
+            _mm512_storeu_si512(out, _mm512_ternarylogic_epi64(result, and_v, or_v, 0xEA));
+
+            b = _mm512_xor_si512(b, a);
+            a = _mm512_xor_si512(_mm512_xor_si512(_mm512_rol_epi64(a, 49), b), _mm512_slli_epi64(b, 21));
+            b = _mm512_rol_epi64(b, 28);
+
+            out += 64;
+        }
+
+        _mm512_store_si512(s0.data(), a);
+        _mm512_store_si512(s1.data(), b);
+        return num_steps;
+    }
+#endif
+
+    inline void xoroshiro128pp_x8::fill(void* out, size_t num_blocks, std::array<uint8_t, 16> const& and_mask, std::array<uint8_t, 16> const& or_mask) noexcept
+    {
+        std::array<uint64_t, 2> and_words, or_words;
+        memcpy(and_words.data(), and_mask.data(), sizeof(and_words));
+        memcpy(or_words.data(), or_mask.data(), sizeof(or_words));
+
+        auto* bytes = static_cast<uint8_t*>(out);
+        size_t const num_steps = num_blocks / s_blocks_per_step;
+        size_t done = 0;
+
+#ifdef UUID_LIB_USE_SIMD
+        if (detail::has_avx512f())
+        {
+            done = fill_avx512(bytes, num_steps, and_words, or_words);
+        }
+        else if (detail::has_avx2())
+        {
+            done = fill_avx2(bytes, num_steps, and_words, or_words);
+        }
+#endif
+        alignas(64) std::array<uint64_t, s_num_lanes> words;
+        for (; done < num_steps; ++done)
+        {
+            step_scalar(words.data(), and_words, or_words);
+            memcpy(bytes + done * sizeof(words), words.data(), sizeof(words));
+        }
+
+        // The blocks of a last, partial step
+        size_t const remaining = num_blocks - num_steps * s_blocks_per_step;
+        if (remaining > 0)
+        {
+            step_scalar(words.data(), and_words, or_words);
+            memcpy(bytes + num_steps * sizeof(words), words.data(), remaining * 16);
+        }
+    }
+}
@@ -1,15 +1,37 @@
 #include <gtest/gtest.h>
 
-#include "uuid.h"
-#include <uuid_factory.h>
+#include <filesystem>
+#include <random>
+#include <ranges>
+#include <sstream>
+#include <thread>
+#include <unordered_set>
+
+#include "uuid.hpp"
+#include "uuid_bulk.hpp"
+#include <uuid_sequencer.hpp>
+#include <uuid_clock.hpp>
+#include <uuid_column.hpp>
+#include <uuid_concurrent.hpp>
+#include <uuid_factory.hpp>
+#include <uuid_flat_map.hpp>
+#include <uuid_format.hpp>
+#include <uuid_index.hpp>
+#include <uuid_name.hpp>
+#include <uuid_pool.hpp>
+#include <uuid_search.hpp>
+#include <uuid_sort.hpp>
+#include <uuid_v8.hpp>
 
 using namespace LambdaSnail::Uuid;
 
+static uuid_factory<std::mt19937_64> factory;
+
 TEST(UuidOperations, CopiedUuid_ShouldBeEqual)
 {
     // Arrange
     uuid a;
-    factory::create_uuid_v4(a);
+    factory.create_uuid_v4(a);
     uuid b = a;
 
     // Assert
@@ -24,12 +46,7 @@ TEST(UuidOperations, NilAndMax_ShouldBeDifferent)
 
 bool uuid_lt_reference(uuid const &a, uuid const &b)
 {
-    for (uint8_t i = 0; i < 16; ++i)
-    {
-        if (a.octets[i] < b.octets[i]) return true;
-    }
-
-    return false;
+    return std::lexicographical_compare(a.octets.begin(), a.octets.end(), b.octets.begin(), b.octets.end());
 }
 
 TEST(UuidOperations, Nil_ShouldBeLessThanMax)
@@ -39,13 +56,40 @@ TEST(UuidOperations, Nil_ShouldBeLessThanMax)
 
 TEST(UuidOperations, Nil_ShouldBeLessThanOrEqualMax)
 {
-    EXPECT_TRUE(uuid::nil < uuid::max);
+    EXPECT_TRUE(uuid::nil <= uuid::max);
+}
+
+TEST(UuidOperations, ThreeWayComparison_ShouldMatchOctetOrder)
+{
+    std::vector<uuid> ids(64);
+    for (uuid& id : ids)
+    {
+        factory.create_uuid_v4(id);
+    }
+
+    // Uuids that only differ in a single octet, in both halves
+    uuid low_diff = ids[0];
+    ++low_diff.octets[15];
+    ids.push_back(low_diff);
+    uuid high_diff = ids[0];
+    high_diff.octets[0] ^= 0x80;
+    ids.push_back(high_diff);
+
+    for (uuid const& a : ids)
+    {
+        for (uuid const& b : ids)
+        {
+            EXPECT_EQ(a < b, uuid_lt_reference(a, b));
+            EXPECT_EQ(a > b, uuid_lt_reference(b, a));
+            EXPECT_EQ((a <=> b) == 0, a == b);
+        }
+    }
 }
 
 TEST(UuidOperations, AnyV4_ShouldBeLessThanMax)
 {
     uuid v4;
-    factory::create_uuid_v4(v4);
+    factory.create_uuid_v4(v4);
 
     EXPECT_TRUE(v4 < uuid::max);
 }
@@ -53,7 +97,7 @@ TEST(UuidOperations, AnyV4_ShouldBeLessThanMax)
 TEST(UuidOperations, AnyV7_ShouldBeLessThanMax)
 {
     uuid v7;
-    factory::create_uuid_v7(v7);
+    factory.create_uuid_v7(v7);
 
     EXPECT_TRUE(v7 < uuid::max);
 }
@@ -61,7 +105,1452 @@ TEST(UuidOperations, AnyV7_ShouldBeLessThanMax)
 TEST(UuidOperations, TwoConsecutiveV7_FirstShouldBeLessThanLast)
 {
     std::vector<uuid> uuids;
-    factory::create_uuids_dedicated_counter(2, uuids);
+    factory.create_uuids_dedicated_counter(2, uuids);
 
     EXPECT_TRUE(uuids[0] < uuids[1]);
-}
\ No newline at end of file
+}
+
+TEST(UuidOperations, MonotonicBatch_ShouldBeSorted)
+{
+    std::vector<uuid> uuids;
+    factory.create_uuids_monotonic_random(1000, 1, uuids);
+
+    EXPECT_TRUE(std::is_sorted(uuids.begin(), uuids.end()));
+}
+
+TEST(UuidOperations, BatchIntoNonEmptyVector_ShouldAppend)
+{
+    std::vector<uuid> uuids(3, uuid::max);
+    factory.create_uuids_dedicated_counter(100, uuids);
+    factory.create_uuids_monotonic_random(100, 2, uuids);
+
+    ASSERT_EQ(uuids.size(), 203);
+    EXPECT_TRUE(uuids[0] == uuid::max and uuids[2] == uuid::max);
+    EXPECT_TRUE(std::is_sorted(uuids.begin() + 3, uuids.begin() + 103));
+    EXPECT_TRUE(std::is_sorted(uuids.begin() + 103, uuids.end()));
+    EXPECT_EQ(uuids[3].octets[6] >> 4, 7);
+    EXPECT_EQ(uuids[103].octets[8] >> 6, 0b10);
+}
+
+TEST(UuidOperations, RandomIncrementBatch_ShouldStepByBoundedRandomIncrements)
+{
+    uint32_t constexpr max_increment = 1000;
+    std::vector<uuid> uuids;
+    factory.create_uuids_random_increment(5000, max_increment, uuids);
+    ASSERT_EQ(uuids.size(), 5000);
+
+    auto const counter = [](uuid const& id)
+    {
+        uint64_t value = 0;
+        for (size_t i = 8; i < 16; ++i)
+        {
+            value = value << 8 | id.octets[i];
+        }
+
+        return value & ((static_cast<uint64_t>(1) << 62) - 1);
+    };
+
+    std::unordered_set<uint64_t> increments;
+    for (size_t i = 1; i < uuids.size(); ++i)
+    {
+        ASSERT_TRUE(uuids[i - 1] < uuids[i]);
+        EXPECT_TRUE(std::equal(uuids[i].octets.begin(), uuids[i].octets.begin() + 8, uuids[0].octets.begin()));
+        EXPECT_EQ(uuids[i].octets[8] >> 6, 0b10);
+
+        uint64_t const increment = counter(uuids[i]) - counter(uuids[i - 1]);
+        EXPECT_TRUE(increment >= 1 and increment <= max_increment);
+        increments.insert(increment);
+    }
+
+    // Not a fixed increment
+    EXPECT_GT(increments.size(), max_increment / 2);
+}
+
+TEST(UuidOperations, AccumulateIncrements_ShouldMatchBaseline)
+{
+    std::mt19937 random_engine(17);
+    std::vector<uint32_t> random(1003);
+    std::ranges::generate(random, random_engine);
+
+    for (uint32_t max_increment : { 1u, 7u, 0xFFFFFFFFu })
+    {
+        std::vector<uint64_t> expected(random.size());
+        uint64_t const expected_sum = detail::accumulate_increments_baseline(random.data(), random.size(), max_increment, 42, expected.data());
+        EXPECT_EQ(expected_sum, expected.back());
+
+        std::vector<uint64_t> actual(random.size());
+        EXPECT_EQ(detail::accumulate_increments(random.data(), random.size(), max_increment, 42, actual.data()), expected_sum);
+        EXPECT_EQ(actual, expected);
+
+#ifdef UUID_LIB_USE_SIMD
+        if (detail::has_avx2())
+        {
+            std::ranges::fill(actual, 0);
+            EXPECT_EQ(detail::accumulate_increments_avx2(random.data(), random.size(), max_increment, 42, actual.data()), expected_sum);
+            EXPECT_EQ(actual, expected);
+        }
+
+        if (detail::has_avx512f())
+        {
+            std::ranges::fill(actual, 0);
+            EXPECT_EQ(detail::accumulate_increments_avx512(random.data(), random.size(), max_increment, 42, actual.data()), expected_sum);
+            EXPECT_EQ(actual, expected);
+        }
+#endif
+    }
+}
+
+TEST(UuidOperations, BatchOutputs_ShouldWriteRequestedUuids)
+{
+    std::vector<uuid> span_ids(500, uuid::max);
+    factory.create_uuids_dedicated_counter(std::span(span_ids).first(499));
+    EXPECT_TRUE(std::is_sorted(span_ids.begin(), span_ids.begin() + 499));
+    EXPECT_TRUE(span_ids[499] == uuid::max);
+
+    factory.create_uuids_monotonic_random(span_ids, 7);
+    EXPECT_TRUE(std::adjacent_find(span_ids.begin(), span_ids.end(), std::greater_equal<>()) == span_ids.end());
+
+    factory.create_uuids_random_increment(span_ids, 7);
+    EXPECT_TRUE(std::adjacent_find(span_ids.begin(), span_ids.end(), std::greater_equal<>()) == span_ids.end());
+
+    std::vector<uuid> iterator_ids(10);
+    EXPECT_TRUE(factory.create_uuids_monotonic_random(10, 1, iterator_ids.data()) == iterator_ids.data() + 10);
+    EXPECT_TRUE(std::is_sorted(iterator_ids.begin(), iterator_ids.end()));
+
+    alignas(16) std::array<uint8_t, 16 * 64> raw;
+    factory.create_uuids_dedicated_counter(64, raw.data());
+    for (size_t i = 0; i < 64; ++i)
+    {
+        uuid::octet_set_t octets;
+        memcpy(octets.data(), raw.data() + 16 * i, octets.size());
+
+        EXPECT_EQ(octets[6] >> 4, 7);
+        EXPECT_EQ(((octets[6] & 0x0F) << 8) | octets[7], i);
+    }
+}
+
+TEST(UuidOperations, V7View_ShouldYieldIncreasingUuidsAcrossBlocks)
+{
+    uuid_factory<std::mt19937_64> view_factory;
+    auto view = view_factory.v7_view<64>();
+    static_assert(std::ranges::input_range<decltype(view)>);
+    static_assert(std::ranges::view<decltype(view)>);
+
+    std::vector<uuid> uuids;
+    std::ranges::copy(std::move(view) | std::views::take(1000), std::back_inserter(uuids));
+
+    ASSERT_EQ(uuids.size(), 1000);
+    EXPECT_TRUE(std::adjacent_find(uuids.begin(), uuids.end(), std::greater_equal<>()) == uuids.end());
+
+    // The view shares its sequence with the single uuid functions of the factory
+    uuid next;
+    view_factory.create_uuid_v7_monotonic(next);
+    EXPECT_TRUE(uuids.back() < next);
+}
+
+TEST(UuidOperations, V4View_ShouldYieldDistinctV4Uuids)
+{
+    std::unordered_set<uuid> unique;
+    for (uuid const& id : factory.v4_view() | std::views::take(1000))
+    {
+        EXPECT_EQ(id.octets[6] >> 4, 4);
+        unique.insert(id);
+    }
+
+    EXPECT_EQ(unique.size(), 1000);
+}
+
+TEST(UuidOperations, V4Batch_ShouldSetVersionAndVariant)
+{
+    for (size_t size : { 0, 1, 3, 4, 5, 999 })
+    {
+        std::vector<uuid> uuids(size + 1, uuid::max);
+        factory.create_uuids_v4(std::span(uuids).first(size));
+
+        for (size_t i = 0; i < size; ++i)
+        {
+            EXPECT_EQ(uuids[i].octets[6] >> 4, 4);
+            EXPECT_EQ(uuids[i].octets[8] >> 6, 0b10);
+        }
+
+        // The uuid after the span is left alone
+        EXPECT_TRUE(uuids[size] == uuid::max);
+
+        std::unordered_set<uuid> const unique(uuids.begin(), uuids.begin() + size);
+        EXPECT_EQ(unique.size(), size);
+    }
+}
+
+TEST(UuidOperations, GeneratorLanes_ShouldMatchJumpedGenerators)
+{
+    xoroshiro128pp generator;
+    generator.seed_state({ 0x0123456789ABCDEFull, 0xFEDCBA9876543210ull });
+
+    xoroshiro128pp_x8 lanes;
+    lanes.seed(generator);
+
+    size_t constexpr num_steps = 5;
+    std::array<uint64_t, num_steps * xoroshiro128pp_x8::s_num_lanes> words;
+    uuid::octet_set_t all_ones;
+    all_ones.fill(0xFF);
+    lanes.fill(words.data(), words.size() / 2, all_ones, uuid::nil.octets);
+
+    // Lane i is the generator advanced by i jumps, and each step writes one output of every lane in lane order
+    for (size_t lane = 0; lane < xoroshiro128pp_x8::s_num_lanes; ++lane)
+    {
+        xoroshiro128pp reference;
+        reference.seed_state({ generator.get_state()[0], generator.get_state()[1] });
+        for (size_t i = 0; i < lane; ++i)
+        {
+            reference.jump();
+        }
+
+        for (size_t step = 0; step < num_steps; ++step)
+        {
+            EXPECT_EQ(words[step * xoroshiro128pp_x8::s_num_lanes + lane], reference());
+        }
+    }
+}
+
+TEST(UuidOperations, MonotonicV7_ShouldBeStrictlyIncreasing)
+{
+    uuid_factory<std::mt19937_64> monotonic_factory;
+    std::vector<uuid> uuids(10000);
+    for (uuid& id : uuids)
+    {
+        monotonic_factory.create_uuid_v7_monotonic(id);
+    }
+
+    EXPECT_TRUE(std::adjacent_find(uuids.begin(), uuids.end(), std::greater_equal<>()) == uuids.end());
+    for (uuid const& id : uuids)
+    {
+        EXPECT_EQ(id.octets[6] >> 4, 7);
+        EXPECT_EQ(id.octets[8] >> 6, 0b10);
+    }
+}
+
+struct manual_clock
+{
+    std::chrono::nanoseconds time{};
+
+    std::chrono::nanoseconds now() const noexcept { return time; }
+};
+
+TEST(UuidOperations, MonotonicV7_ShouldStayIncreasingWhenClockGoesBack)
+{
+    using namespace std::chrono_literals;
+
+    uuid_factory<std::mt19937_64, manual_clock> manual_factory;
+    manual_clock& clock = manual_factory.get_clock();
+
+    std::vector<uuid> uuids(6);
+    clock.time = 1'700'000'000'000ms + 500us;
+    manual_factory.create_uuid_v7_monotonic(uuids[0]);
+    manual_factory.create_uuid_v7_monotonic(uuids[1]);
+    clock.time -= 1s;
+    manual_factory.create_uuid_v7_monotonic(uuids[2]);
+    manual_factory.create_uuid_v7_monotonic(uuids[3]);
+    clock.time += 2s;
+    manual_factory.create_uuid_v7_monotonic(uuids[4]);
+    manual_factory.create_uuid_v7_monotonic(uuids[5]);
+
+    EXPECT_TRUE(std::adjacent_find(uuids.begin(), uuids.end(), std::greater_equal<>()) == uuids.end());
+
+    // Half a millisecond is 2048 steps of 1/4096 ms
+    EXPECT_EQ(uuids[0].octets[6] & 0x0F, 0x8);
+    EXPECT_EQ(uuids[0].octets[7], 0x00);
+    EXPECT_EQ(uuids[1].octets[7], 0x01);
+    EXPECT_EQ(uuids[3].octets[7], 0x03);
+    EXPECT_EQ(uuids[4].octets[7], 0x00);
+}
+
+template<typename clock_policy_t>
+void expect_close_to_system_clock()
+{
+    using namespace std::chrono_literals;
+
+    clock_policy_t clock;
+    for (size_t i = 0; i < 20; ++i)
+    {
+        std::chrono::nanoseconds const expected = system_clock_policy().now();
+        std::chrono::nanoseconds const actual = clock.now();
+
+        EXPECT_LT(std::chrono::abs(actual - expected), 50ms);
+        std::this_thread::sleep_for(1ms);
+    }
+}
+
+/**
+ * Advances by a fixed step every time it is read.
+ */
+struct stepping_clock
+{
+    std::chrono::nanoseconds time{};
+    std::chrono::nanoseconds step{};
+
+    std::chrono::nanoseconds now() noexcept { return time += step; }
+};
+
+TEST(UuidOperations, RollingCounter_ShouldStayIncreasingAcrossCallsInOneMillisecond)
+{
+    using namespace std::chrono_literals;
+
+    uuid_factory<std::mt19937_64, manual_clock> manual_factory;
+    manual_factory.get_clock().time = 1'700'000'000'000ms;
+
+    // Without the rollover, the counter of a 5000 uuid batch would wrap, and the second call would repeat it
+    std::vector<uuid> uuids;
+    manual_factory.create_uuids_rolling_counter(5000, uuids);
+    manual_factory.create_uuids_rolling_counter(100, uuids);
+
+    ASSERT_EQ(uuids.size(), 5100);
+    EXPECT_TRUE(std::adjacent_find(uuids.begin(), uuids.end(), std::greater_equal<>()) == uuids.end());
+
+    // The first 4096 share the timestamp of the clock, with counters 0..4095, and the rest have the next millisecond
+    EXPECT_TRUE(std::equal(uuids[0].octets.begin(), uuids[0].octets.begin() + 6, uuids[4095].octets.begin()));
+    EXPECT_EQ((uuids[4095].octets[6] & 0x0F) << 8 | uuids[4095].octets[7], 4095);
+    EXPECT_EQ((uuids[4096].octets[6] & 0x0F) << 8 | uuids[4096].octets[7], 0);
+    EXPECT_EQ(uuids[4096].octets[5], static_cast<uint8_t>(uuids[0].octets[5] + 1));
+    EXPECT_EQ(uuids[4096].octets[6] >> 4, 7);
+}
+
+TEST(UuidOperations, RollingCounter_ShouldWaitForClockAtMaxSkew)
+{
+    using namespace std::chrono_literals;
+
+    uuid_factory<std::mt19937_64, stepping_clock> stepping_factory;
+    stepping_clock& clock = stepping_factory.get_clock();
+    clock.time = 1'700'000'000'000ms;
+    clock.step = 100us;
+
+    std::vector<uuid> uuids;
+    stepping_factory.create_uuids_rolling_counter(4096 * 6, uuids, 2ms);
+    EXPECT_TRUE(std::adjacent_find(uuids.begin(), uuids.end(), std::greater_equal<>()) == uuids.end());
+
+    // Six milliseconds of uuids can only be created within a skew of 2 ms once the clock has moved forward by 3 ms
+    auto const timestamp = [](uuid const& id)
+    {
+        uint64_t value = 0;
+        for (size_t i = 0; i < 6; ++i)
+        {
+            value = value << 8 | id.octets[i];
+        }
+
+        return value;
+    };
+
+    uint64_t const clock_ms = std::chrono::duration_cast<std::chrono::milliseconds>(clock.time).count();
+    EXPECT_EQ(timestamp(uuids.back()) - timestamp(uuids.front()), 5);
+    EXPECT_LE(timestamp(uuids.back()), clock_ms + 2);
+    EXPECT_GE(clock_ms, timestamp(uuids.front()) + 3);
+}
+
+TEST(UuidOperations, RollingCounter_ShouldNotWaitForClockSetBackwards)
+{
+    using namespace std::chrono_literals;
+
+    uuid_factory<std::mt19937_64, stepping_clock> stepping_factory;
+    stepping_clock& clock = stepping_factory.get_clock();
+    clock.time = 1'700'000'000'000ms;
+    clock.step = 100us;
+
+    std::vector<uuid> uuids;
+    stepping_factory.create_uuids_rolling_counter(4096 * 2, uuids, 2ms);
+
+    // After the clock steps back an hour, the batch only waits until the clock has moved into the third millisecond
+    // (the 6 ms it creates, less the skew), instead of until the clock is back where it was
+    clock.time -= 1h;
+    std::chrono::nanoseconds const regressed = clock.time;
+    stepping_factory.create_uuids_rolling_counter(4096 * 6, uuids, 2ms);
+
+    EXPECT_TRUE(std::adjacent_find(uuids.begin(), uuids.end(), std::greater_equal<>()) == uuids.end());
+    EXPECT_GT(clock.time - regressed, 2ms);
+    EXPECT_LT(clock.time - regressed, 10ms);
+}
+
+TEST(UuidOperations, V8_ShouldEmbedShardAndTimestamp)
+{
+    using namespace std::chrono_literals;
+    using default_layout = v8_layout<>;
+    using wide_shard_layout = v8_layout<v8_field{ 0, 40 }, v8_field{ 66, 20 }>;
+
+    uuid_factory<std::mt19937_64, manual_clock> manual_factory;
+    manual_factory.get_clock().time = 1'700'000'000'123ms;
+
+    uuid id;
+    manual_factory.create_uuid_v8<default_layout>(0xABC, id);
+    EXPECT_EQ(id.octets[6] >> 4, 8);
+    EXPECT_EQ(id.octets[8] >> 6, 0b10);
+    EXPECT_EQ(default_layout::shard(id), 0xABC);
+    EXPECT_EQ(default_layout::timestamp_ms(id), 1'700'000'000'123);
+
+    // Bits above the field width are dropped
+    manual_factory.create_uuid_v8<wide_shard_layout>(0xF12345, id);
+    EXPECT_EQ(id.octets[6] >> 4, 8);
+    EXPECT_EQ(id.octets[8] >> 6, 0b10);
+    EXPECT_EQ(wide_shard_layout::shard(id), 0x12345);
+    EXPECT_EQ(wide_shard_layout::timestamp_ms(id), 1'700'000'000'123 & 0xFF'FFFF'FFFF);
+
+    std::vector<uuid> batch;
+    manual_factory.create_uuids_v8<wide_shard_layout>(1000, 77, batch);
+    ASSERT_EQ(batch.size(), 1000);
+    for (uuid const& batch_id : batch)
+    {
+        EXPECT_EQ(batch_id.octets[6] >> 4, 8);
+        EXPECT_EQ(batch_id.octets[8] >> 6, 0b10);
+        EXPECT_EQ(wide_shard_layout::shard(batch_id), 77);
+        EXPECT_EQ(wide_shard_layout::timestamp_ms(batch_id), wide_shard_layout::timestamp_ms(id));
+    }
+
+    EXPECT_EQ(std::unordered_set<uuid>(batch.begin(), batch.end()).size(), batch.size());
+}
+
+TEST(UuidOperations, V8Shard_ShouldBeConstantExpression)
+{
+    constexpr uuid id(uuid::octet_set_t{ 0, 0, 0, 0, 0, 1, 0x8A, 0xBC, 0x80, 0, 0, 0, 0, 0, 0, 0 });
+    static_assert(v8_layout<>::shard(id) == 0xABC);
+    static_assert(v8_layout<>::timestamp_ms(id) == 1);
+    static_assert(v8_layout<v8_field{ 0, 48 }, v8_field{ 66, 6 }>::shard(id) == 0);
+}
+
+TEST(UuidOperations, NameBased_ShouldMatchKnownUuids)
+{
+    auto const expect_uuid = [](uuid const& id, std::string_view expected)
+    {
+        uuid expected_id;
+        ASSERT_EQ(uuid::from_string(expected, expected_id), std::errc{});
+        EXPECT_EQ(id, expected_id) << id.as_string();
+    };
+
+    // Empty names, names that need a second padding block and names longer than one block
+    std::string const long_name(300, 'x');
+    std::string const medium_name(100, 'a');
+
+    uuid id;
+    factory.create_uuid_v5(namespace_dns, "python.org", id);
+    expect_uuid(id, "886313e1-3b8a-5372-9b90-0c9aee199e5d");
+    factory.create_uuid_v5(namespace_dns, "", id);
+    expect_uuid(id, "4ebd0208-8328-5d69-8c44-ec50939c0967");
+    factory.create_uuid_v5(namespace_url, long_name, id);
+    expect_uuid(id, "458bdf5e-edc1-5563-9c58-3b789b486616");
+
+    factory.create_uuid_v3(namespace_dns, "python.org", id);
+    expect_uuid(id, "6fa459ea-ee8a-3ca4-894e-db77e160355e");
+    factory.create_uuid_v3(namespace_oid, medium_name, id);
+    expect_uuid(id, "8589ba99-5a46-385b-a8ce-56c02cb19b30");
+}
+
+TEST(UuidOperations, NameBasedBatch_ShouldMatchSingleUuids)
+{
+    // Names of every length up to a few blocks, and some too long for the multi-buffer hash
+    std::vector<std::string> storage;
+    for (size_t length = 0; length < 300; length += 7)
+    {
+        storage.emplace_back(length, static_cast<char>('a' + length % 26));
+    }
+
+    std::vector<std::string_view> const names(storage.begin(), storage.end());
+    std::vector<uuid> ids(names.size());
+
+    for (uuid const& name_space : { namespace_dns, namespace_x500 })
+    {
+        factory.create_uuids_v5(name_space, names, ids);
+        for (size_t i = 0; i < names.size(); ++i)
+        {
+            uuid expected;
+            factory.create_uuid_v5(name_space, names[i], expected);
+            EXPECT_EQ(ids[i], expected) << names[i].size();
+
+            std::array<uint32_t, 5> state = detail::s_sha1_initial_state;
+            detail::hash_name(state, name_space, names[i], true, &detail::sha1_compress_baseline);
+            detail::sha1_state_to_uuid(state[0], state[1], state[2], state[3], expected);
+            EXPECT_EQ(ids[i], expected) << names[i].size();
+        }
+
+#ifdef UUID_LIB_USE_SIMD
+        cpu_features const& features = get_cpu_features();
+        std::vector<uuid> simd_ids(names.size());
+        if (features.avx2)
+        {
+            detail::create_uuids_v5_multi_buffer<detail::sha1_ops_avx2::s_lanes>(name_space, names, simd_ids, &detail::sha1_multi_buffer_avx2);
+            EXPECT_EQ(simd_ids, ids);
+        }
+
+        if (features.avx512f)
+        {
+            detail::create_uuids_v5_multi_buffer<detail::sha1_ops_avx512::s_lanes>(name_space, names, simd_ids, &detail::sha1_multi_buffer_avx512);
+            EXPECT_EQ(simd_ids, ids);
+        }
+#endif
+
+        factory.create_uuids_v3(name_space, names, ids);
+        for (size_t i = 0; i < names.size(); ++i)
+        {
+            uuid expected;
+            factory.create_uuid_v3(name_space, names[i], expected);
+            EXPECT_EQ(ids[i], expected);
+        }
+    }
+}
+
+TEST(UuidClock, ClockPolicies_ShouldBeCloseToSystemClock)
+{
+    expect_close_to_system_clock<coarse_clock_policy>();
+    expect_close_to_system_clock<tsc_clock_policy>();
+    expect_close_to_system_clock<cached_clock_policy>();
+}
+
+TEST(UuidParsing, StandardString_ShouldRoundTrip)
+{
+    uuid v4;
+    factory.create_uuid_v4(v4);
+
+    uuid parsed;
+    EXPECT_EQ(uuid::from_string(v4.as_string(), parsed), std::errc{});
+    EXPECT_TRUE(parsed == v4);
+}
+
+TEST(UuidParsing, AllModes_ShouldRoundTrip)
+{
+    uuid v7;
+    factory.create_uuid_v7(v7);
+
+    uuid braced, no_dash;
+    EXPECT_EQ(uuid::from_string<string_conversion_mode::curly_braces>(v7.as_string<string_conversion_mode::curly_braces>(), braced), std::errc{});
+    EXPECT_EQ(uuid::from_string<string_conversion_mode::no_dash>(v7.as_string<string_conversion_mode::no_dash>(), no_dash), std::errc{});
+
+    EXPECT_TRUE(braced == v7);
+    EXPECT_TRUE(no_dash == v7);
+}
+
+template<string_conversion_mode M>
+static void expect_compact_round_trip_and_order(std::vector<uuid> const& ids)
+{
+    for (size_t i = 0; i < ids.size(); ++i)
+    {
+        std::string const text = ids[i].as_string<M>();
+        ASSERT_EQ(text.size(), string_length<M>);
+
+        uuid parsed;
+        EXPECT_EQ(uuid::from_string<M>(text, parsed), std::errc{}) << text;
+        EXPECT_EQ(parsed, ids[i]) << text;
+
+        if (i > 0 and M != string_conversion_mode::base64url)
+        {
+            EXPECT_EQ(ids[i - 1] < ids[i], ids[i - 1].as_string<M>() < text) << text;
+        }
+    }
+}
+
+TEST(UuidParsing, CompactModes_ShouldRoundTripAndKeepOrder)
+{
+    std::vector<uuid> ids(500);
+    factory.create_uuids_v7_monotonic(std::span(ids).first(250));
+    for (uuid& id : std::span(ids).subspan(250))
+    {
+        factory.create_uuid_v4(id);
+    }
+
+    ids.push_back(uuid::nil);
+    ids.push_back(uuid::max);
+
+    expect_compact_round_trip_and_order<string_conversion_mode::base64url>(ids);
+    expect_compact_round_trip_and_order<string_conversion_mode::base32>(ids);
+    expect_compact_round_trip_and_order<string_conversion_mode::base58>(ids);
+}
+
+TEST(UuidParsing, CompactModes_MalformedStrings_ShouldFail)
+{
+    uuid parsed = uuid::max;
+
+    // Characters of standard base64, and bits left over in the last character
+    EXPECT_EQ(uuid::from_string<string_conversion_mode::base64url>("AYkKXayWd0u8zrMCCZqA+w", parsed), std::errc::invalid_argument);
+    EXPECT_EQ(uuid::from_string<string_conversion_mode::base64url>("AYkKXayWd0u8zrMCCZqAV=", parsed), std::errc::invalid_argument);
+    EXPECT_EQ(uuid::from_string<string_conversion_mode::base64url>("AYkKXayWd0u8zrMCCZqAVx", parsed), std::errc::invalid_argument);
+    EXPECT_EQ(uuid::from_string<string_conversion_mode::base64url>("AYkKXayWd0u8zrMCCZqAV", parsed), std::errc::invalid_argument);
+
+    // More than 128 bits, and a letter that is not in the alphabet
+    EXPECT_EQ(uuid::from_string<string_conversion_mode::base32>("81H455VB4PEX5VSKNK084SN02Q", parsed), std::errc::invalid_argument);
+    EXPECT_EQ(uuid::from_string<string_conversion_mode::base32>("01H455VB4PEX5VSKNK084SN02U", parsed), std::errc::invalid_argument);
+    EXPECT_EQ(uuid::from_string<string_conversion_mode::base32>("01H455VB4PEX5-SKNK084SN02Q", parsed), std::errc::invalid_argument);
+
+    // 2^128 itself, and characters that are left out of the alphabet
+    EXPECT_EQ(uuid::from_string<string_conversion_mode::base58>("YcVfxkQb6JRzqk5kF2tNLw", parsed), std::errc::invalid_argument);
+    EXPECT_EQ(uuid::from_string<string_conversion_mode::base58>("1BzmjTFLHWXwiSK4y3H5i0", parsed), std::errc::invalid_argument);
+    EXPECT_EQ(uuid::from_string<string_conversion_mode::base58>("1BzmjTFLHWXwiSK4y3H5il", parsed), std::errc::invalid_argument);
+
+    EXPECT_TRUE(parsed == uuid::max);
+
+    // Crockford's base32 is read without regard to case, with O as 0 and I as 1
+    EXPECT_EQ(uuid::from_string<string_conversion_mode::base32>("oih455vb4pex5vsknk084sn02q", parsed), std::errc{});
+    EXPECT_EQ(parsed.as_string<string_conversion_mode::base32>(), "01H455VB4PEX5VSKNK084SN02Q");
+}
+
+TEST(UuidParsing, MixedCase_ShouldParse)
+{
+    uuid parsed;
+    EXPECT_EQ(uuid::from_string("0189ABcd-eF01-7a2B-8C3d-4E5f60718293", parsed), std::errc{});
+
+    uuid::octet_set_t const expected = { 0x01, 0x89, 0xab, 0xcd, 0xef, 0x01, 0x7a, 0x2b, 0x8c, 0x3d, 0x4e, 0x5f, 0x60, 0x71, 0x82, 0x93 };
+    EXPECT_TRUE(parsed == uuid(expected));
+}
+
+TEST(UuidParsing, MalformedStrings_ShouldFail)
+{
+    uuid parsed = uuid::max;
+
+    EXPECT_EQ(uuid::from_string("0189abcd-ef01-7a2b-8c3d-4e5f6071829", parsed), std::errc::invalid_argument);
+    EXPECT_EQ(uuid::from_string("0189abcd-ef01-7a2b-8c3d-4e5f607182930", parsed), std::errc::invalid_argument);
+    EXPECT_EQ(uuid::from_string("0189abcd-ef01-7a2b-8c3d-4e5f6071829g", parsed), std::errc::invalid_argument);
+    EXPECT_EQ(uuid::from_string("0189abcd+ef01-7a2b-8c3d-4e5f60718293", parsed), std::errc::invalid_argument);
+    EXPECT_EQ(uuid::from_string<string_conversion_mode::curly_braces>("{0189abcd-ef01-7a2b-8c3d-4e5f60718293)", parsed), std::errc::invalid_argument);
+    EXPECT_EQ(uuid::from_string<string_conversion_mode::no_dash>("0189abcd-ef017a2b8c3d4e5f60718293", parsed), std::errc::invalid_argument);
+
+    EXPECT_TRUE(parsed == uuid::max);
+}
+
+TEST(UuidParsing, FromChars_ShouldStopAfterUuid)
+{
+    std::string_view const text = "00000000-0000-0000-0000-000000000000,rest";
+
+    uuid parsed = uuid::max;
+    auto const [ptr, ec] = from_chars(text.data(), text.data() + text.size(), parsed);
+
+    EXPECT_EQ(ec, std::errc{});
+    EXPECT_EQ(*ptr, ',');
+    EXPECT_TRUE(parsed == uuid::nil);
+}
+
+TEST(UuidFormatting, AllModes_ShouldMatchKnownStrings)
+{
+    uuid::octet_set_t const octets = { 0x01, 0x89, 0xab, 0xcd, 0xef, 0x01, 0x7a, 0x2b, 0x8c, 0x3d, 0x4e, 0x5f, 0x60, 0x71, 0x82, 0x93 };
+    uuid const id(octets);
+
+    EXPECT_EQ(id.as_string(), "0189abcd-ef01-7a2b-8c3d-4e5f60718293");
+    EXPECT_EQ(id.as_string<string_conversion_mode::curly_braces>(), "{0189abcd-ef01-7a2b-8c3d-4e5f60718293}");
+    EXPECT_EQ(id.as_string<string_conversion_mode::no_dash>(), "0189abcdef017a2b8c3d4e5f60718293");
+}
+
+TEST(UuidFormatting, CompactModes_ShouldMatchKnownStrings)
+{
+    uuid const id(uuid::octet_set_t{ 0x01, 0x89, 0x0a, 0x5d, 0xac, 0x96, 0x77, 0x4b, 0xbc, 0xce, 0xb3, 0x02, 0x09, 0x9a, 0x80, 0x57 });
+
+    EXPECT_EQ(id.as_string<string_conversion_mode::base64url>(), "AYkKXayWd0u8zrMCCZqAVw");
+    EXPECT_EQ(id.as_string<string_conversion_mode::base32>(), "01H455VB4PEX5VSKNK084SN02Q");
+    EXPECT_EQ(id.as_string<string_conversion_mode::base58>(), "1BzmjTFLHWXwiSK4y3H5iW");
+
+    EXPECT_EQ(uuid::max.as_string<string_conversion_mode::base64url>(), "_____________________w");
+    EXPECT_EQ(uuid::max.as_string<string_conversion_mode::base32>(), "7ZZZZZZZZZZZZZZZZZZZZZZZZZ");
+    EXPECT_EQ(uuid::max.as_string<string_conversion_mode::base58>(), "YcVfxkQb6JRzqk5kF2tNLv");
+
+    EXPECT_EQ(uuid::nil.as_string<string_conversion_mode::base64url>(), "AAAAAAAAAAAAAAAAAAAAAA");
+    EXPECT_EQ(uuid::nil.as_string<string_conversion_mode::base32>(), "00000000000000000000000000");
+    EXPECT_EQ(uuid::nil.as_string<string_conversion_mode::base58>(), "1111111111111111111111");
+}
+
+TEST(UuidFormatting, ToChars_ShouldWriteIntoBuffer)
+{
+    std::array<char, 40> buffer{};
+    auto const [ptr, ec] = to_chars(std::span<char>(buffer), uuid::max);
+
+    EXPECT_EQ(ec, std::errc{});
+    EXPECT_EQ(ptr, buffer.data() + string_length<string_conversion_mode::standard>);
+    EXPECT_EQ(std::string_view(buffer.data(), ptr), "ffffffff-ffff-ffff-ffff-ffffffffffff");
+    EXPECT_EQ(buffer[36], '\0');
+}
+
+TEST(UuidFormatting, ToChars_ShouldFailOnSmallBuffer)
+{
+    std::array<char, 35> buffer{};
+    auto const [ptr, ec] = to_chars(buffer.data(), buffer.data() + buffer.size(), uuid::max);
+
+    EXPECT_EQ(ec, std::errc::value_too_large);
+    EXPECT_EQ(ptr, buffer.data() + buffer.size());
+}
+
+template<string_conversion_mode M>
+static void expect_bulk_format_matches_as_string(std::vector<uuid> const& ids)
+{
+    std::string expected;
+    for (uuid const& id : ids)
+    {
+        expected += id.as_string<M>();
+        expected += '\n';
+    }
+
+    std::string buffer(bulk_string_length<M>(ids.size()), '\0');
+    auto const [ptr, ec] = format_uuids<M>(ids, '\n', buffer);
+
+    EXPECT_EQ(ec, std::errc{});
+    EXPECT_EQ(ptr, buffer.data() + buffer.size());
+    EXPECT_EQ(buffer, expected);
+}
+
+TEST(UuidBulkFormatting, AllModes_ShouldMatchAsString)
+{
+    std::vector<uuid> ids(7);
+    for (uuid& id : ids)
+    {
+        factory.create_uuid_v4(id);
+    }
+
+    expect_bulk_format_matches_as_string<string_conversion_mode::standard>(ids);
+    expect_bulk_format_matches_as_string<string_conversion_mode::curly_braces>(ids);
+    expect_bulk_format_matches_as_string<string_conversion_mode::no_dash>(ids);
+    expect_bulk_format_matches_as_string<string_conversion_mode::base64url>(ids);
+    expect_bulk_format_matches_as_string<string_conversion_mode::base32>(ids);
+    expect_bulk_format_matches_as_string<string_conversion_mode::base58>(ids);
+}
+
+TEST(UuidBulkFormatting, SmallBuffer_ShouldFail)
+{
+    std::vector<uuid> const ids(3, uuid::max);
+    std::string buffer(bulk_string_length(ids.size()) - 1, '\0');
+
+    auto const [ptr, ec] = format_uuids(ids, ',', buffer);
+    EXPECT_EQ(ec, std::errc::value_too_large);
+}
+
+TEST(UuidBulkParsing, FormattedText_ShouldRoundTrip)
+{
+    std::vector<uuid> ids(9);
+    for (uuid& id : ids)
+    {
+        factory.create_uuid_v7(id);
+    }
+
+    std::string text(bulk_string_length(ids.size()), '\0');
+    std::ignore = format_uuids(ids, '\n', text);
+
+    std::vector<uuid> parsed;
+    parse_uuids_result const result = parse_uuids(text, parsed);
+
+    EXPECT_EQ(result.ec, std::errc{});
+    EXPECT_EQ(result.num_parsed, ids.size());
+    EXPECT_EQ(result.offset, text.size());
+    EXPECT_EQ(parsed, ids);
+}
+
+TEST(UuidBulkParsing, CompactText_ShouldRoundTrip)
+{
+    std::vector<uuid> ids(9);
+    for (uuid& id : ids)
+    {
+        factory.create_uuid_v4(id);
+    }
+
+    std::string text(bulk_string_length<string_conversion_mode::base64url>(ids.size()), '\0');
+    std::ignore = format_uuids<string_conversion_mode::base64url>(ids, ',', text);
+
+    std::vector<uuid> parsed;
+    parse_uuids_result const result = parse_uuids<string_conversion_mode::base64url>(text, parsed);
+
+    EXPECT_EQ(result.ec, std::errc{});
+    EXPECT_EQ(result.num_parsed, ids.size());
+    EXPECT_EQ(parsed, ids);
+}
+
+TEST(UuidBulkParsing, MixedSeparators_ShouldBeSkipped)
+{
+    std::string_view const text = "00000000-0000-0000-0000-000000000000\r\nFFFFFFFF-FFFF-FFFF-FFFF-FFFFFFFFFFFF,00000000-0000-0000-0000-000000000000";
+
+    std::array<uuid, 3> parsed;
+    parse_uuids_result const result = parse_uuids(text, parsed);
+
+    EXPECT_EQ(result.ec, std::errc{});
+    EXPECT_EQ(result.num_parsed, 3);
+    EXPECT_TRUE(parsed[0] == uuid::nil);
+    EXPECT_TRUE(parsed[1] == uuid::max);
+    EXPECT_TRUE(parsed[2] == uuid::nil);
+}
+
+TEST(UuidBulkParsing, MalformedEntry_ShouldReportOffset)
+{
+    std::string_view const text = "00000000000000000000000000000000\n0000000000000000000000000000000x\n00000000000000000000000000000000";
+
+    std::array<uuid, 3> parsed;
+    parsed.fill(uuid::max);
+    parse_uuids_result const result = parse_uuids<string_conversion_mode::no_dash>(text, parsed);
+
+    EXPECT_EQ(result.ec, std::errc::invalid_argument);
+    EXPECT_EQ(result.num_parsed, 1);
+    EXPECT_EQ(result.offset, 33);
+
+    // The slots past the reported ones are left as they were
+    EXPECT_EQ(parsed[0], uuid::nil);
+    EXPECT_EQ(parsed[1], uuid::max);
+    EXPECT_EQ(parsed[2], uuid::max);
+}
+
+TEST(UuidBulkParsing, FullOutput_ShouldReportValueTooLarge)
+{
+    std::string_view const text = "00000000000000000000000000000000,00000000000000000000000000000000";
+
+    std::array<uuid, 1> parsed;
+    parse_uuids_result const result = parse_uuids<string_conversion_mode::no_dash>(text, parsed);
+
+    EXPECT_EQ(result.ec, std::errc::value_too_large);
+    EXPECT_EQ(result.num_parsed, 1);
+    EXPECT_EQ(result.offset, 33);
+}
+
+TEST(UuidStdFormat, FormatSpecs_ShouldMatchKnownStrings)
+{
+    uuid::octet_set_t const octets = { 0x01, 0x89, 0xab, 0xcd, 0xef, 0x01, 0x7a, 0x2b, 0x8c, 0x3d, 0x4e, 0x5f, 0x60, 0x71, 0x82, 0x93 };
+    uuid const id(octets);
+
+    EXPECT_EQ(std::format("{}", id), "0189abcd-ef01-7a2b-8c3d-4e5f60718293");
+    EXPECT_EQ(std::format("{:#}", id), "{0189abcd-ef01-7a2b-8c3d-4e5f60718293}");
+    EXPECT_EQ(std::format("{:u}", id), "0189ABCD-EF01-7A2B-8C3D-4E5F60718293");
+    EXPECT_EQ(std::format("{:#u}", id), "{0189ABCD-EF01-7A2B-8C3D-4E5F60718293}");
+    EXPECT_EQ(std::format("{:u#}", id), "{0189ABCD-EF01-7A2B-8C3D-4E5F60718293}");
+    EXPECT_EQ(std::format("{:n}", id), "0189abcdef017a2b8c3d4e5f60718293");
+    EXPECT_EQ(std::format("{:r}", id), "urn:uuid:0189abcd-ef01-7a2b-8c3d-4e5f60718293");
+    EXPECT_EQ(std::format("{:ru}", id), "urn:uuid:0189ABCD-EF01-7A2B-8C3D-4E5F60718293");
+}
+
+TEST(UuidHash, DistinctUuids_ShouldHashDifferently)
+{
+    std::vector<uuid> ids;
+    factory.create_uuids_monotonic_random(10000, 1, ids);
+
+    std::unordered_set<size_t> hashes;
+    for (uuid const& id : ids)
+    {
+        hashes.insert(std::hash<uuid>{}(id));
+    }
+
+    EXPECT_EQ(hashes.size(), ids.size());
+}
+
+TEST(UuidFlatMap, InsertFindErase_ShouldBehaveLikeAMap)
+{
+    std::vector<uuid> ids(5000);
+    for (uuid& id : ids)
+    {
+        factory.create_uuid_v4(id);
+    }
+
+    uuid_flat_map<size_t> map;
+    for (size_t i = 0; i < ids.size(); ++i)
+    {
+        EXPECT_TRUE(map.try_emplace(ids[i], i).second);
+    }
+
+    EXPECT_EQ(map.size(), ids.size());
+    EXPECT_FALSE(map.try_emplace(ids[0], 42).second);
+
+    for (size_t i = 0; i < ids.size(); i += 2)
+    {
+        EXPECT_EQ(map.erase(ids[i]), 1);
+    }
+
+    EXPECT_EQ(map.size(), ids.size() / 2);
+    for (size_t i = 0; i < ids.size(); ++i)
+    {
+        auto const it = map.find(ids[i]);
+        if (i % 2 == 0)
+        {
+            EXPECT_TRUE(it == map.end());
+        }
+        else
+        {
+            ASSERT_TRUE(it != map.end());
+            EXPECT_EQ(it->second, i);
+        }
+    }
+
+    size_t num_iterated = 0;
+    for (auto const& [key, value] : map)
+    {
+        EXPECT_TRUE(key == ids[value]);
+        ++num_iterated;
+    }
+
+    EXPECT_EQ(num_iterated, map.size());
+
+    map[uuid::max] += 3;
+    EXPECT_EQ(map[uuid::max], 3);
+}
+
+TEST(UuidFlatSet, CopiedSet_ShouldContainSameUuids)
+{
+    uuid_flat_set set;
+    set.insert(uuid::nil);
+    set.insert(uuid::max);
+    set.insert(uuid::max);
+
+    uuid_flat_set const copy = set;
+
+    EXPECT_EQ(copy.size(), 2);
+    EXPECT_TRUE(copy.contains(uuid::nil));
+    EXPECT_TRUE(copy.contains(uuid::max));
+    EXPECT_FALSE(copy.contains(uuid(0x42)));
+}
+
+TEST(UuidSort, RandomV4_ShouldMatchStdSort)
+{
+    std::vector<uuid> ids(20000);
+    for (uuid& id : ids)
+    {
+        factory.create_uuid_v4(id);
+    }
+
+    // Duplicates and uuids sharing long prefixes
+    ids[1] = ids[0];
+    ids[2] = ids[0];
+    ids[2].octets[15] ^= 1;
+
+    std::vector<uuid> expected = ids;
+    std::sort(expected.begin(), expected.end());
+
+    uuid_sort(ids);
+    EXPECT_EQ(ids, expected);
+}
+
+TEST(UuidSort, ShuffledV7_ShouldMatchStdSort)
+{
+    std::vector<uuid> ids;
+    factory.create_uuids_dedicated_counter(4000, ids);
+
+    std::vector<uuid> expected = ids;
+    std::sort(expected.begin(), expected.end());
+
+    std::shuffle(ids.begin(), ids.end(), std::mt19937_64());
+    uuid_sort(ids);
+    EXPECT_EQ(ids, expected);
+}
+
+TEST(UuidSort, Parallel_ShouldMatchStdSort)
+{
+    std::vector<uuid> ids(100000);
+    for (uuid& id : ids)
+    {
+        factory.create_uuid_v7(id);
+        id.octets[7] ^= static_cast<uint8_t>(std::hash<uuid>{}(id));
+    }
+
+    std::vector<uuid> expected = ids;
+    std::sort(expected.begin(), expected.end());
+
+    uuid_sort_parallel(ids, 4);
+    EXPECT_EQ(ids, expected);
+}
+
+TEST(UuidSearch, IndexOf_ShouldMatchStdFind)
+{
+    std::vector<uuid> ids(37);
+    for (uuid& id : ids)
+    {
+        factory.create_uuid_v4(id);
+    }
+
+    ids[30] = ids[5];
+
+    for (size_t i = 0; i < ids.size(); ++i)
+    {
+        EXPECT_EQ(uuid_index_of(ids, ids[i]), std::find(ids.begin(), ids.end(), ids[i]) - ids.begin());
+    }
+
+    // A uuid with only one equal half must not match
+    uuid half_match = ids[12];
+    half_match.octets[3] ^= 1;
+
+    EXPECT_EQ(uuid_index_of(ids, half_match), ids.size());
+    EXPECT_TRUE(uuid_find(ids, ids[36]) == std::span<uuid const>(ids).begin() + 36);
+    EXPECT_TRUE(uuid_contains(ids, ids[20]));
+    EXPECT_FALSE(uuid_contains(ids, uuid::max));
+    EXPECT_EQ(uuid_count(ids, ids[5]), 2);
+    EXPECT_EQ(uuid_count(ids, ids[6]), 1);
+}
+
+TEST(UuidSearch, MultipleNeedles_ShouldFindFirstOccurrences)
+{
+    std::vector<uuid> ids(50);
+    for (uuid& id : ids)
+    {
+        factory.create_uuid_v7(id);
+    }
+
+    std::vector<uuid> const needles = { ids[49], uuid::nil, ids[0], ids[17], ids[49] };
+    std::vector<size_t> indices(needles.size());
+    uuid_index_of(ids, needles, indices);
+
+    EXPECT_EQ(indices, (std::vector<size_t>{ 49, 50, 0, 17, 49 }));
+}
+
+TEST(UuidCpuDispatch, Kernels_ShouldMatchPortablePath)
+{
+    std::vector<uuid> ids(29);
+    for (uuid& id : ids)
+    {
+        factory.create_uuid_v4(id);
+    }
+
+    ids[21] = ids[3];
+    [[maybe_unused]] cpu_features const& features = get_cpu_features();
+
+    for (uuid const& id : ids)
+    {
+        char expected[string_length<string_conversion_mode::standard>];
+        detail::format_octets_scalar<string_conversion_mode::standard>(id.octets.data(), expected, false);
+
+        alignas(16) uuid::octet_set_t scalar_octets;
+        ASSERT_TRUE(detail::parse_octets_scalar<string_conversion_mode::standard>(expected, scalar_octets.data()));
+        EXPECT_EQ(scalar_octets, id.octets);
+
+#ifdef UUID_LIB_USE_SIMD
+        alignas(16) uuid::octet_set_t octets;
+        if (features.ssse3)
+        {
+            char chars[string_length<string_conversion_mode::standard>];
+            detail::format_octets_ssse3<string_conversion_mode::standard>(id.octets.data(), chars, false);
+            EXPECT_EQ(std::string_view(chars, sizeof(chars)), std::string_view(expected, sizeof(expected)));
+
+            ASSERT_TRUE(detail::parse_octets_ssse3<string_conversion_mode::standard>(expected, octets.data()));
+            EXPECT_EQ(octets, id.octets);
+
+            char scalar_compact[string_length<string_conversion_mode::base32>];
+            char compact[string_length<string_conversion_mode::base32>];
+            detail::encode_base64url_scalar(id.octets.data(), scalar_compact);
+            detail::encode_base64url_ssse3(id.octets.data(), compact);
+            EXPECT_EQ(std::string_view(compact, 22), std::string_view(scalar_compact, 22));
+            ASSERT_TRUE(detail::decode_base64url_ssse3(compact, octets.data()));
+            EXPECT_EQ(octets, id.octets);
+
+            detail::encode_base32_scalar(id.octets.data(), scalar_compact);
+            detail::encode_base32_ssse3(id.octets.data(), compact);
+            EXPECT_EQ(std::string_view(compact, 26), std::string_view(scalar_compact, 26));
+            ASSERT_TRUE(detail::decode_base32_ssse3(compact, octets.data()));
+            EXPECT_EQ(octets, id.octets);
+        }
+
+        if (features.avx2)
+        {
+            ASSERT_TRUE(detail::parse_octets_avx2<string_conversion_mode::standard>(expected, octets.data()));
+            EXPECT_EQ(octets, id.octets);
+            EXPECT_EQ(detail::index_of_avx2(ids, id), uuid_index_of(ids, id));
+            EXPECT_EQ(detail::count_avx2(ids, id), uuid_count(ids, id));
+        }
+
+        if (features.avx512f)
+        {
+            EXPECT_EQ(detail::index_of_avx512(ids, id), uuid_index_of(ids, id));
+            EXPECT_EQ(detail::count_avx512(ids, id), uuid_count(ids, id));
+        }
+#endif
+
+        EXPECT_EQ(detail::index_of_impl(ids, id, detail::block_matcher_baseline{}), uuid_index_of(ids, id));
+    }
+}
+
+TEST(UuidConcurrentFactory, Threads_ShouldCreateDistinctUuids)
+{
+    size_t constexpr num_threads = 8;
+    size_t constexpr num_uuids = 1000;
+
+    std::vector<std::vector<uuid>> per_thread(num_threads, std::vector<uuid>(num_uuids));
+    {
+        std::vector<std::jthread> threads;
+        for (size_t t = 0; t < num_threads; ++t)
+        {
+            threads.emplace_back([&ids = per_thread[t]]
+            {
+                concurrent_uuid_factory<> concurrent_factory;
+                for (uuid& id : ids)
+                {
+                    concurrent_factory.create_uuid_v4(id);
+                }
+            });
+        }
+    }
+
+    std::unordered_set<uuid> unique;
+    for (std::vector<uuid> const& ids : per_thread)
+    {
+        unique.insert(ids.begin(), ids.end());
+    }
+
+    EXPECT_EQ(unique.size(), num_threads * num_uuids);
+}
+
+TEST(UuidConcurrentFactory, ThreadStream_ShouldBeJumpedRootStream)
+{
+    uint64_t first_value = 0;
+    std::jthread([&] { first_value = concurrent_uuid_factory<>::local().get_generator()(); }).join();
+
+    // The generator of the n-th thread starts from the root state advanced by n jumps
+    std::array<uint64_t, 2> const& root = detail::root_stream_state();
+    bool found = false;
+    for (size_t stream = 0; stream < 64 and not found; ++stream)
+    {
+        xoroshiro128pp reference;
+        reference.seed_state({ root[0], root[1] });
+        for (size_t i = 0; i < stream; ++i)
+        {
+            reference.jump();
+        }
+
+        found = reference() == first_value;
+    }
+
+    EXPECT_TRUE(found);
+}
+
+TEST(UuidPool, Consumers_ShouldTakeDistinctUuids)
+{
+    size_t constexpr num_threads = 4;
+    size_t constexpr num_uuids = 5000;
+
+    // A small pool, so that consumers also run it empty and create uuids themselves
+    uuid_pool<> pool(uuid_pool_kind::v4, { .depth = 64, .low_water_mark = 16 });
+    std::vector<std::vector<uuid>> per_thread(num_threads, std::vector<uuid>(num_uuids));
+    {
+        std::vector<std::jthread> threads;
+        for (size_t t = 0; t < num_threads; ++t)
+        {
+            threads.emplace_back([&pool, &ids = per_thread[t]]
+            {
+                for (uuid& id : ids)
+                {
+                    pool.pop(id);
+                }
+            });
+        }
+    }
+
+    std::unordered_set<uuid> unique;
+    for (std::vector<uuid> const& ids : per_thread)
+    {
+        for (uuid const& id : ids)
+        {
+            EXPECT_EQ(id.octets[6] >> 4, 4);
+            EXPECT_EQ(id.octets[8] >> 6, 2);
+        }
+
+        unique.insert(ids.begin(), ids.end());
+    }
+
+    EXPECT_EQ(unique.size(), num_threads * num_uuids);
+}
+
+TEST(UuidPool, V7_ShouldHandOutIncreasingUuidsInPoolOrder)
+{
+    size_t constexpr depth = 1024;
+    uuid_pool<> pool(uuid_pool_kind::v7, { .depth = depth, .low_water_mark = 256 });
+
+    // Empty the pool several times, so the producer has to refill it after the low-water mark is passed. Only the
+    // uuids the pool reports are taken, so the test does not depend on how far the producer got
+    std::vector<uuid> ids;
+    while (ids.size() < 4 * depth)
+    {
+        auto const deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+        while (pool.size() == 0 and std::chrono::steady_clock::now() < deadline)
+        {
+            std::this_thread::yield();
+        }
+
+        size_t const available = pool.size();
+        ASSERT_GT(available, 0);
+        for (size_t i = 0; i < available; ++i)
+        {
+            ASSERT_TRUE(pool.try_pop(ids.emplace_back()));
+        }
+    }
+
+    EXPECT_EQ(pool.num_fallbacks(), 0);
+    EXPECT_TRUE(std::adjacent_find(ids.begin(), ids.end(), std::greater_equal<>()) == ids.end());
+}
+
+TEST(UuidSequencer, Block_ShouldHoldConsecutiveIncreasingUuids)
+{
+    v7_sequencer<> sequencer;
+    std::vector<uuid> uuids(5000);
+    factory.create_uuids_v7(sequencer, uuids);
+
+    EXPECT_TRUE(std::adjacent_find(uuids.begin(), uuids.end(), std::greater_equal<>()) == uuids.end());
+
+    uuid next;
+    factory.create_uuid_v7(sequencer, next);
+    EXPECT_TRUE(uuids.back() < next);
+}
+
+TEST(UuidSequencer, SharedBetweenThreads_ShouldHandOutUniqueIncreasingSlots)
+{
+    size_t constexpr num_threads = 8;
+    size_t constexpr num_claims = 2000;
+
+    v7_sequencer<cached_clock_policy> sequencer;
+    std::vector<std::vector<uint64_t>> per_thread(num_threads);
+    {
+        std::vector<std::jthread> threads;
+        for (size_t t = 0; t < num_threads; ++t)
+        {
+            threads.emplace_back([&sequencer, &ticks = per_thread[t], t]
+            {
+                for (size_t i = 0; i < num_claims; ++i)
+                {
+                    // Mix single claims and blocks
+                    uint64_t const count = (i + t) % 4 == 0 ? 3 : 1;
+                    uint64_t const first = sequencer.claim(count);
+                    for (uint64_t k = 0; k < count; ++k)
+                    {
+                        ticks.push_back(first + k);
+                    }
+                }
+            });
+        }
+    }
+
+    std::vector<uint64_t> all;
+    for (std::vector<uint64_t> const& ticks : per_thread)
+    {
+        EXPECT_TRUE(std::is_sorted(ticks.begin(), ticks.end()));
+        all.insert(all.end(), ticks.begin(), ticks.end());
+    }
+
+    std::sort(all.begin(), all.end());
+    EXPECT_TRUE(std::adjacent_find(all.begin(), all.end()) == all.end());
+    EXPECT_EQ(sequencer.last(), all.back());
+}
+
+TEST(UuidSequencer, ClockGoingBack_ShouldKeepIncreasing)
+{
+    using namespace std::chrono_literals;
+
+    v7_sequencer<manual_clock> sequencer;
+    sequencer.get_clock().time = 1'700'000'000'000ms;
+
+    uint64_t const first = sequencer.claim(10);
+    sequencer.get_clock().time -= 1s;
+    EXPECT_EQ(sequencer.claim(), first + 10);
+
+    sequencer.get_clock().time += 2s;
+    EXPECT_EQ(sequencer.claim(), detail::to_v7_tick(sequencer.get_clock().time));
+}
+
+TEST(UuidColumn, Batches_ShouldRoundTrip)
+{
+    std::vector<uuid> ids;
+    factory.create_uuids_monotonic_random(1000, 1, ids);
+    factory.create_uuids_random_increment(1000, 1u << 20, ids);
+    factory.create_uuids_dedicated_counter(1000, ids);
+    for (int i = 0; i < 300; ++i)
+    {
+        factory.create_uuid_v4(ids.emplace_back());
+    }
+    ids.push_back(uuid::nil);
+    ids.push_back(uuid::max);
+
+    uuid_column column;
+    column.append(std::span(ids).first(77));
+    column.append(std::span(ids).subspan(77, 500));
+    for (uuid const& id : std::span(ids).subspan(577))
+    {
+        column.push_back(id);
+    }
+
+    ASSERT_EQ(column.size(), ids.size());
+    for (size_t i = 0; i < ids.size(); ++i)
+    {
+        EXPECT_EQ(column[i], ids[i]);
+    }
+
+    std::vector<uuid> decoded;
+    column.for_each_block([&decoded](std::span<uuid const> block) { decoded.insert(decoded.end(), block.begin(), block.end()); });
+    EXPECT_EQ(decoded, ids);
+
+    std::vector<uuid> part(301);
+    column.decode(1190, part);
+    EXPECT_TRUE(std::equal(part.begin(), part.end(), ids.begin() + 1190));
+}
+
+TEST(UuidColumn, MonotonicBatch_ShouldTakeLessMemory)
+{
+    std::vector<uuid> ids;
+    factory.create_uuids_monotonic_random(128 * 64, 1, ids);
+
+    uuid_column column;
+    column.append(ids);
+
+    EXPECT_LT(column.memory_usage() * 4, ids.size() * sizeof(uuid));
+}
+
+TEST(UuidColumn, DecodeKernels_ShouldMatchBaseline)
+{
+    std::mt19937_64 generator(7);
+    [[maybe_unused]] cpu_features const& features = get_cpu_features();
+
+    for (uint32_t width : { 0u, 1u, 7u, 13u, 33u, 48u, 63u, 64u })
+    {
+        // Pack both halves with the same width, each block in its own allocation so reads past it are caught
+        std::array<uint64_t, detail::s_column_block_size> values;
+        std::ranges::generate(values, [&generator, width] { return generator() & detail::bit_width_mask(width); });
+
+        std::vector<uint64_t> words(4 * width, 0);
+        detail::pack_bits(values.data(), width, words.data());
+        detail::pack_bits(values.data(), width, words.data() + 2 * width);
+
+        detail::column_block const block{ .hi_base = generator(), .lo_base = 0, .word_offset = 0, .hi_width = static_cast<uint8_t>(width), .lo_width = static_cast<uint8_t>(width) };
+
+        for (size_t first : { 0, 3, 64, 121 })
+        {
+            size_t const count = detail::s_column_block_size - first;
+            std::vector<uuid> expected(count);
+            detail::decode_column_block_baseline(block, words.data(), first, count, expected.data()->octets.data());
+
+            for (size_t i = 0; i < count; ++i)
+            {
+                EXPECT_EQ(detail::load_big_endian(expected[i].octets.data()), block.hi_base + values[first + i]);
+                EXPECT_EQ(detail::load_big_endian(expected[i].octets.data() + 8), values[first + i]);
+            }
+
+#ifdef UUID_LIB_USE_SIMD
+            std::vector<uuid> decoded(count);
+            if (features.avx2)
+            {
+                detail::decode_column_block_avx2(block, words.data(), first, count, decoded.data()->octets.data());
+                EXPECT_EQ(decoded, expected);
+            }
+
+            if (features.avx512f)
+            {
+                detail::decode_column_block_avx512(block, words.data(), first, count, decoded.data()->octets.data());
+                EXPECT_EQ(decoded, expected);
+            }
+#endif
+        }
+    }
+}
+
+TEST(UuidIndex, MappedFile_ShouldFindAllUuids)
+{
+    std::vector<uuid> ids;
+    factory.create_uuids_random_increment(5000, 1000, ids);
+    factory.create_uuids_monotonic_random(3000, 1, ids);
+    for (int i = 0; i < 2000; ++i)
+    {
+        factory.create_uuid_v7(ids.emplace_back());
+    }
+    ids.push_back(ids[17]);
+    ids.push_back(uuid::nil);
+    uuid_sort(ids);
+
+    // A name of its own, so that test runs in parallel do not write the same file
+    uuid file_id;
+    factory.create_uuid_v4(file_id);
+    std::filesystem::path const path = std::filesystem::temp_directory_path() / ("uuid_index_test_" + file_id.as_string() + ".bin");
+    ASSERT_EQ(write_uuid_index(ids, path), std::errc{});
+
+    uuid_index_file index;
+    ASSERT_EQ(index.open(path), std::errc{});
+    ASSERT_EQ(index.size(), ids.size());
+    EXPECT_TRUE(std::ranges::equal(index.view().ids(), ids));
+
+    std::vector<uuid> needles(ids.begin(), ids.end());
+    for (int i = 0; i < 1000; ++i)
+    {
+        factory.create_uuid_v4(needles.emplace_back());
+    }
+    needles.push_back(uuid::max);
+
+    std::vector<size_t> indices(needles.size());
+    index.find(needles, indices);
+    for (size_t i = 0; i < needles.size(); ++i)
+    {
+        auto const it = std::lower_bound(ids.begin(), ids.end(), needles[i]);
+        size_t const expected = it != ids.end() and *it == needles[i] ? static_cast<size_t>(it - ids.begin()) : ids.size();
+        EXPECT_EQ(index.find(needles[i]), expected);
+        EXPECT_EQ(indices[i], expected);
+    }
+
+    uuid_index_file moved = std::move(index);
+    EXPECT_FALSE(index.is_open());
+    EXPECT_TRUE(moved.contains(ids[42]));
+
+    moved.close();
+    std::filesystem::remove(path);
+}
+
+TEST(UuidIndex, EmptySet_ShouldFindNothing)
+{
+    std::stringstream stream;
+    ASSERT_EQ(write_uuid_index({}, stream), std::errc{});
+
+    std::string const bytes = stream.str();
+    std::vector<uuid> storage(bytes.size() / sizeof(uuid));
+    memcpy(storage.data(), bytes.data(), bytes.size());
+
+    uuid_index_view view;
+    ASSERT_EQ(uuid_index_view::from_bytes(std::as_bytes(std::span(storage)), view), std::errc{});
+    EXPECT_TRUE(view.empty());
+    EXPECT_FALSE(view.contains(uuid::nil));
+
+    std::vector<uuid> const needles = { uuid::nil, uuid::max };
+    std::vector<size_t> indices(needles.size(), 1);
+    view.find(needles, indices);
+    EXPECT_TRUE(std::ranges::all_of(indices, [](size_t index) { return index == 0; }));
+}
+
+TEST(UuidIndex, UnopenedFile_ShouldFindNothing)
+{
+    uuid_index_file index;
+    EXPECT_FALSE(index.is_open());
+    EXPECT_EQ(index.size(), 0);
+    EXPECT_EQ(index.find(uuid::nil), 0);
+
+    std::vector<uuid> needles(20);
+    for (uuid& id : needles)
+    {
+        factory.create_uuid_v4(id);
+    }
+
+    std::vector<size_t> indices(needles.size(), 1);
+    index.find(needles, indices);
+    EXPECT_TRUE(std::ranges::all_of(indices, [](size_t index) { return index == 0; }));
+
+    index.close();
+    std::ranges::fill(indices, 1);
+    index.find(needles, indices);
+    EXPECT_TRUE(std::ranges::all_of(indices, [](size_t index) { return index == 0; }));
+}
+
+TEST(UuidIndex, MalformedInput_ShouldFail)
+{
+    std::vector<uuid> ids(100);
+    for (uuid& id : ids)
+    {
+        factory.create_uuid_v4(id);
+    }
+
+    std::stringstream unsorted;
+    EXPECT_EQ(write_uuid_index(ids, unsorted), std::errc::invalid_argument);
+
+    uuid_sort(ids);
+    std::stringstream stream;
+    ASSERT_EQ(write_uuid_index(ids, stream), std::errc{});
+    std::string const bytes = stream.str();
+    std::vector<uuid> storage(bytes.size() / sizeof(uuid));
+    memcpy(storage.data(), bytes.data(), bytes.size());
+
+    uuid_index_view view;
+    std::span<std::byte const> const valid = std::as_bytes(std::span(storage));
+    EXPECT_EQ(uuid_index_view::from_bytes(valid.first(valid.size() - sizeof(uuid)), view), std::errc::invalid_argument);
+    EXPECT_EQ(uuid_index_view::from_bytes(valid.first(16), view), std::errc::invalid_argument);
+
+    // A header whose model does not match the uuids: a different smallest uuid, and a shift that is too small
+    std::vector<uuid> corrupt = storage;
+    corrupt[2].octets[8] ^= 0x01; // min_hi
+    EXPECT_EQ(uuid_index_view::from_bytes(std::as_bytes(std::span(corrupt)), view), std::errc::invalid_argument);
+
+    corrupt = storage;
+    std::fill_n(corrupt[2].octets.begin(), 8, 0); // shift
+    EXPECT_EQ(uuid_index_view::from_bytes(std::as_bytes(std::span(corrupt)), view), std::errc::invalid_argument);
+
+    ASSERT_EQ(uuid_index_view::from_bytes(valid, view), std::errc{});
+    storage[0].octets[0] ^= 0xFF;
+    EXPECT_EQ(uuid_index_view::from_bytes(valid, view), std::errc::invalid_argument);
+
+    uuid_index_file index;
+    EXPECT_EQ(index.open(std::filesystem::temp_directory_path() / "uuid_index_missing.bin"), std::errc::no_such_file_or_directory);
+}